@@ -0,0 +1,287 @@
+#include "AllocationCounter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+#ifdef COUNT_ALLOCATIONS
+namespace {
+    std::atomic<std::size_t> allocationCount(0);
+    std::atomic<std::size_t> allocationBytes(0);
+
+#ifdef TRACK_ALLOCATIONS
+    const std::size_t phaseCount = static_cast<std::size_t>(AllocationCounter::Phase::Count);
+
+    // Constant initialised, so it is safe to read from operator new at any point
+    thread_local AllocationCounter::Phase currentPhase = AllocationCounter::Phase::Other;
+
+    std::atomic<std::size_t> phaseAllocations[phaseCount];
+    std::atomic<std::size_t> phaseBytes[phaseCount];
+    std::atomic<std::size_t> phaseFrees[phaseCount];
+#endif
+
+    void record(std::size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+#ifdef TRACK_ALLOCATIONS
+        std::size_t phase = static_cast<std::size_t>(currentPhase);
+        phaseAllocations[phase].fetch_add(1, std::memory_order_relaxed);
+        phaseBytes[phase].fetch_add(size, std::memory_order_relaxed);
+#endif
+    }
+
+    void recordFree(void* pointer) {
+#ifdef TRACK_ALLOCATIONS
+        if (pointer != nullptr) {
+            phaseFrees[static_cast<std::size_t>(currentPhase)].fetch_add(1, std::memory_order_relaxed);
+        }
+#else
+        (void)pointer;
+#endif
+    }
+
+    void* allocate(std::size_t size) {
+        record(size);
+
+        // malloc(0) may return null, which new must not
+        return std::malloc(size != 0 ? size : 1);
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+        record(size);
+
+        std::size_t align = static_cast<std::size_t>(alignment);
+        size = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+#ifdef _MSC_VER
+        return _aligned_malloc(size, align);
+#else
+        return std::aligned_alloc(align, size);
+#endif
+    }
+
+    void deallocate(void* pointer) {
+        recordFree(pointer);
+        std::free(pointer);
+    }
+
+    void freeAligned(void* pointer) {
+        recordFree(pointer);
+#ifdef _MSC_VER
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+#endif
+
+/*
+ *  Returns the number of heap allocations made through operator new since startup, or
+ *  zero unless this is a COUNT_ALLOCATIONS build.
+ */
+std::size_t AllocationCounter::count() {
+#ifdef COUNT_ALLOCATIONS
+    return allocationCount.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+/*
+ *  Returns the total bytes requested through operator new since startup, or zero unless
+ *  this is a COUNT_ALLOCATIONS build.
+ */
+std::size_t AllocationCounter::bytes() {
+#ifdef COUNT_ALLOCATIONS
+    return allocationBytes.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+/*
+ *  Returns true if this is a COUNT_ALLOCATIONS build, which replaces operator new to fill
+ *  in count and bytes.
+ */
+bool AllocationCounter::counts() {
+#ifdef COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ *  Returns true if this is a TRACK_ALLOCATIONS build, which fills in phaseStats.
+ */
+bool AllocationCounter::tracksPhases() {
+#ifdef TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ *  Returns the allocations, bytes allocated and frees made in a phase since startup or
+ *  the last resetPhases. Frees are counted in the phase that frees, not the one that
+ *  allocated.
+ */
+AllocationCounter::PhaseStats AllocationCounter::phaseStats(Phase phase) {
+    PhaseStats stats;
+#ifdef TRACK_ALLOCATIONS
+    std::size_t index = static_cast<std::size_t>(phase);
+    stats.allocations = phaseAllocations[index].load(std::memory_order_relaxed);
+    stats.bytes = phaseBytes[index].load(std::memory_order_relaxed);
+    stats.frees = phaseFrees[index].load(std::memory_order_relaxed);
+#else
+    (void)phase;
+#endif
+    return stats;
+}
+
+const char* AllocationCounter::phaseName(Phase phase) {
+    switch (phase) {
+    case Phase::Other:
+        return "other";
+    case Phase::Events:
+        return "events";
+    case Phase::Update:
+        return "update";
+    case Phase::Collision:
+        return "collision";
+    case Phase::Render:
+        return "render";
+    case Phase::Hud:
+        return "HUD";
+    default:
+        return "?";
+    }
+}
+
+/*
+ *  Zeroes every phase's counters, e.g. once a second to report rates.
+ */
+void AllocationCounter::resetPhases() {
+#ifdef TRACK_ALLOCATIONS
+    for (std::size_t i = 0; i < phaseCount; ++i) {
+        phaseAllocations[i].store(0, std::memory_order_relaxed);
+        phaseBytes[i].store(0, std::memory_order_relaxed);
+        phaseFrees[i].store(0, std::memory_order_relaxed);
+    }
+#endif
+}
+
+#ifdef TRACK_ALLOCATIONS
+AllocationCounter::Scope::Scope(Phase phase) : previous(currentPhase) {
+    currentPhase = phase;
+}
+
+AllocationCounter::Scope::~Scope() {
+    currentPhase = previous;
+}
+#endif
+
+#ifdef COUNT_ALLOCATIONS
+void* operator new(std::size_t size) {
+    void* pointer = allocate(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    void* pointer = allocate(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+
+// Over-aligned types, and std::pmr::new_delete_resource, use these
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* pointer = allocateAligned(size, alignment);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    void* pointer = allocateAligned(size, alignment);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    freeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    freeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    freeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    freeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    freeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    freeAligned(pointer);
+}
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+
+/*
+ *  Counts calls to the global operator new, plain and aligned. Only instrumentation builds
+ *  pay for this: defining COUNT_ALLOCATIONS makes AllocationCounter.cpp replace the global
+ *  allocation functions for the whole program, while other builds keep the stock allocator
+ *  and count() always reports zero. Sampling count() before and after a piece of code tells
+ *  how many heap allocations it made, e.g. to check that a steady-state tick makes none.
+ *
+ *  Building with TRACK_ALLOCATIONS defined, which implies COUNT_ALLOCATIONS, also
+ *  attributes every allocation and free to the phase of the game loop the allocating
+ *  thread is in, as set by a Scope. Without it a Scope compiles to nothing and phaseStats
+ *  always reports zero.
+ */
+#if defined(TRACK_ALLOCATIONS) && !defined(COUNT_ALLOCATIONS)
+#define COUNT_ALLOCATIONS
+#endif
+
+class AllocationCounter {
+public:
+    enum class Phase { Other, Events, Update, Collision, Render, Hud, Count };
+
+    struct PhaseStats {
+        std::size_t allocations = 0;
+        std::size_t bytes = 0;
+        std::size_t frees = 0;
+    };
+
+    // Attributes this thread's allocations to a phase while it exists, then restores the
+    // enclosing one, so scopes can nest (Collision runs inside Update)
+    class Scope {
+    public:
+        explicit Scope(Phase phase);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+#ifdef TRACK_ALLOCATIONS
+    private:
+        Phase previous;
+#endif
+    };
+
+    static std::size_t count();
+    static std::size_t bytes();
+    static bool counts();
+
+    static bool tracksPhases();
+    static PhaseStats phaseStats(Phase phase);
+    static const char* phaseName(Phase phase);
+    static void resetPhases();
+};
+
+#ifndef TRACK_ALLOCATIONS
+inline AllocationCounter::Scope::Scope(Phase) {}
+inline AllocationCounter::Scope::~Scope() {}
+#endif
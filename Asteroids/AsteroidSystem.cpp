@@ -0,0 +1,92 @@
+#include "AsteroidSystem.h"
+#include <algorithm>
+#include <cmath>
+
+AsteroidSystem::AsteroidSystem(TextureManager& textureManager) : textureManager(&textureManager) {
+    textures[0] = textureManager.getHandle("AsteroidOneFourth");
+    textures[1] = textureManager.getHandle("AsteroidHalf");
+    textures[2] = textureManager.getHandle("AsteroidFull");
+}
+
+/*
+ *  Adds a motionless asteroid at the origin, for the caller to place.
+ *
+ *  Parameters:
+ *    store: The store to add the asteroid to.
+ *    size:  2 (large), 1 (medium) or 0 (small); clamped to that range.
+ *
+ *  Returns:
+ *    The new asteroid's index.
+ */
+std::size_t AsteroidSystem::spawn(EntityStore& store, int size) {
+    size = std::max(0, std::min(size, 2));
+
+    sf::Vector2u textureSize = textureManager->getTextureSize(textures[size]);
+    std::size_t index = store.add(textures[size],
+        sf::Vector2f(static_cast<float>(textureSize.x), static_cast<float>(textureSize.y)),
+        sf::Vector2f(0.0f, 0.0f), sf::Vector2f(0.0f, 0.0f), 0.0f);
+
+    store.asteroidSize[index] = static_cast<std::uint8_t>(size);
+    return index;
+}
+
+/*
+ *  Moves every asteroid in the store along its velocity.
+ *
+ *  Parameters:
+ *    store:     The store holding the asteroids.
+ *    deltaTime: Time elapsed since the last update cycle.
+ */
+void AsteroidSystem::update(EntityStore& store, sf::Time deltaTime) {
+    float seconds = deltaTime.asSeconds();
+
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        store.position[i] += store.velocity[i] * seconds;
+    }
+}
+
+/*
+ *  Splits an asteroid from large->medium->small by requesting two smaller asteroids at its
+ *  position, heading off within splitAngle of its direction at the same speed. Small
+ *  asteroids do not split. The asteroid itself is left for the caller to destroy.
+ *
+ *  Parameters:
+ *    store:    The store holding the asteroid.
+ *    index:    The asteroid to split.
+ *    commands: The store's command buffer; the pieces join the store when it is flushed.
+ *    random:   The simulation's generator, used to scatter the pieces.
+ */
+void AsteroidSystem::split(const EntityStore& store, std::size_t index, CommandBuffer& commands, std::mt19937& random) {
+
+    EntityStore& spawns = commands.spawns();
+
+    int size = store.asteroidSize[index];
+
+    if (size > 0){
+        for (int i = 0; i < 2; i++) {
+            const float PI = 3.14159265358979323846f;
+
+            sf::Vector2f velocity = store.velocity[index];
+
+            float originalAngle = atan2(velocity.y, velocity.x);
+
+            float angleDeviation = static_cast<float>((static_cast<int>(random() % splitAngle) - splitAngle / 2) * PI / 180.0);
+
+            float newAngleRadians = originalAngle + angleDeviation;
+
+            float speed = sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+
+            sf::Vector2f newVelocity;
+            newVelocity.x = cos(newAngleRadians) * speed;
+            newVelocity.y = sin(newAngleRadians) * speed;
+
+            std::size_t piece = spawn(spawns, size - 1);
+            spawns.position[piece] = store.position[index];
+            spawns.velocity[piece] = newVelocity;
+
+            if (store.wraps[index]) {
+                spawns.setWraps(piece);
+            }
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <random>
+#include "CommandBuffer.h"
+#include "EntityStore.h"
+#include "TextureManager.h"
+
+/*
+ *  Asteroid behaviour over an EntityStore of asteroids: drifting in a straight
+ *  line, and splitting from large->medium->small when destroyed.
+ */
+class AsteroidSystem {
+public:
+    explicit AsteroidSystem(TextureManager& textureManager);
+
+    std::size_t spawn(EntityStore& store, int size);
+    void update(EntityStore& store, sf::Time deltaTime);
+    void split(const EntityStore& store, std::size_t index, CommandBuffer& commands, std::mt19937& random);
+
+private:
+    TextureManager* textureManager;
+
+    // Indexed by asteroid size: 0 (small), 1 (medium), 2 (large)
+    TextureManager::Handle textures[3];
+    int splitAngle = 40;
+};
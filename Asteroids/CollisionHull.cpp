@@ -0,0 +1,236 @@
+#include "CollisionHull.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+    // Twice the signed area of triangle (a, b, c); positive for a counter-clockwise turn
+    float cross(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c) {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    /*
+     *  Returns true if some edge normal of polygon "a" separates the two polygons.
+     */
+    bool hasSeparatingAxis(const sf::Vector2f* a, std::size_t countA, const sf::Vector2f* b, std::size_t countB) {
+        for (std::size_t i = 0; i < countA; ++i) {
+            const sf::Vector2f& p1 = a[i];
+            const sf::Vector2f& p2 = a[(i + 1) % countA];
+            sf::Vector2f axis(p1.y - p2.y, p2.x - p1.x);
+
+            float minA = std::numeric_limits<float>::max(), maxA = std::numeric_limits<float>::lowest();
+            float minB = std::numeric_limits<float>::max(), maxB = std::numeric_limits<float>::lowest();
+
+            for (std::size_t j = 0; j < countA; ++j) {
+                float projection = a[j].x * axis.x + a[j].y * axis.y;
+                minA = std::min(minA, projection);
+                maxA = std::max(maxA, projection);
+            }
+
+            for (std::size_t j = 0; j < countB; ++j) {
+                float projection = b[j].x * axis.x + b[j].y * axis.y;
+                minB = std::min(minB, projection);
+                maxB = std::max(maxB, projection);
+            }
+
+            if (maxA < minB || maxB < minA) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*
+     *  Works out what removing the edge from hull[i] to hull[i + 1] costs: both its ends are
+     *  replaced by the point where the edges either side of it meet when extended. That
+     *  point lies outside the edge, so the polygon only grows. Returns false if the
+     *  neighbouring edges never meet beyond it (they are parallel or diverge).
+     *
+     *  Parameters:
+     *    hull:   A convex polygon with at least four vertices.
+     *    i:      The index of the edge's first vertex.
+     *    corner: Receives the replacement vertex.
+     *    area:   Receives twice the area the polygon grows by.
+     */
+    bool edgeRemoval(const std::vector<sf::Vector2f>& hull, std::size_t i, sf::Vector2f& corner, float& area) {
+        std::size_t count = hull.size();
+        const sf::Vector2f& before = hull[(i + count - 1) % count];
+        const sf::Vector2f& start = hull[i];
+        const sf::Vector2f& end = hull[(i + 1) % count];
+        const sf::Vector2f& after = hull[(i + 2) % count];
+
+        // start + incoming * t meets end + outgoing * s
+        sf::Vector2f incoming = start - before;
+        sf::Vector2f outgoing = after - end;
+        sf::Vector2f gap = end - start;
+        float denominator = incoming.x * outgoing.y - incoming.y * outgoing.x;
+
+        if (std::fabs(denominator) < 1e-6f) {
+            return false;
+        }
+
+        float t = (gap.x * outgoing.y - gap.y * outgoing.x) / denominator;
+        float s = (gap.x * incoming.y - gap.y * incoming.x) / denominator;
+
+        if (t < 0.0f || s > 0.0f) {
+            return false;
+        }
+
+        corner = start + incoming * t;
+        area = std::fabs(cross(start, corner, end));
+        return true;
+    }
+}
+
+CollisionHull::CollisionHull() : vertexCount(0) {
+
+}
+
+/*
+ *  Builds the convex hull of every solid pixel in the mask, then simplifies it until at
+ *  most maxVertices remain by repeatedly removing the edge whose neighbours, extended to
+ *  meet, add the least area (see edgeRemoval). The simplified hull therefore always
+ *  contains the exact one: it can report a touch a few pixels early, next to a cut
+ *  corner, but never misses a contact the mask would find, so tips such as ship noses
+ *  and missile points keep colliding.
+ *
+ *  Parameters:
+ *    mask:        The collision mask to outline.
+ *    maxVertices: The vertex budget for the simplified hull, capped at MAX_VERTICES.
+ */
+CollisionHull::CollisionHull(const CollisionMask& mask, std::size_t maxVertices) : vertexCount(0) {
+    maxVertices = std::max<std::size_t>(3, std::min(maxVertices, MAX_VERTICES));
+
+    // The outermost solid pixel corners on each row are enough to define the hull
+    std::vector<sf::Vector2f> points;
+    sf::Vector2u size = mask.getSize();
+
+    for (unsigned int y = 0; y < size.y; ++y) {
+        int left = -1;
+        int right = -1;
+
+        for (unsigned int x = 0; x < size.x; ++x) {
+            if (mask.isSolid(x, y)) {
+                if (left < 0) {
+                    left = static_cast<int>(x);
+                }
+                right = static_cast<int>(x);
+            }
+        }
+
+        if (left >= 0) {
+            float top = static_cast<float>(y);
+            points.push_back(sf::Vector2f(static_cast<float>(left), top));
+            points.push_back(sf::Vector2f(static_cast<float>(left), top + 1.0f));
+            points.push_back(sf::Vector2f(static_cast<float>(right + 1), top));
+            points.push_back(sf::Vector2f(static_cast<float>(right + 1), top + 1.0f));
+        }
+    }
+
+    if (points.size() < 3) {
+        return;
+    }
+
+    // Andrew's monotone chain
+    std::sort(points.begin(), points.end(), [](const sf::Vector2f& a, const sf::Vector2f& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+        });
+
+    std::vector<sf::Vector2f> hull(points.size() * 2);
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        while (count >= 2 && cross(hull[count - 2], hull[count - 1], points[i]) <= 0.0f) {
+            count--;
+        }
+        hull[count++] = points[i];
+    }
+
+    for (std::size_t i = points.size() - 1, lower = count + 1; i-- > 0;) {
+        while (count >= lower && cross(hull[count - 2], hull[count - 1], points[i]) <= 0.0f) {
+            count--;
+        }
+        hull[count++] = points[i];
+    }
+
+    hull.resize(count - 1);
+
+    // A convex polygon with five or more vertices always has an edge that can go
+    while (hull.size() > maxVertices && hull.size() > 4) {
+        std::size_t cheapest = hull.size();
+        sf::Vector2f cheapestCorner;
+        float cheapestArea = std::numeric_limits<float>::max();
+
+        for (std::size_t i = 0; i < hull.size(); ++i) {
+            sf::Vector2f corner;
+            float area;
+
+            if (edgeRemoval(hull, i, corner, area) && area < cheapestArea) {
+                cheapest = i;
+                cheapestCorner = corner;
+                cheapestArea = area;
+            }
+        }
+
+        if (cheapest == hull.size()) {
+            break;
+        }
+
+        // The corner replaces the edge's first vertex and its second is dropped
+        hull[cheapest] = cheapestCorner;
+        hull.erase(hull.begin() + (cheapest + 1) % hull.size());
+    }
+
+    vertexCount = hull.size();
+    std::copy(hull.begin(), hull.end(), vertices);
+}
+
+std::size_t CollisionHull::getVertexCount() const {
+    return vertexCount;
+}
+
+const sf::Vector2f& CollisionHull::getVertex(std::size_t index) const {
+    return vertices[index];
+}
+
+bool CollisionHull::empty() const {
+    return vertexCount < 3;
+}
+
+/*
+ *  Tests whether two hulls placed in the world overlap, using the separating axis
+ *  theorem on the edge normals of both polygons.
+ *
+ *  Parameters:
+ *    hull1:      The first hull.
+ *    transform1: Maps hull1's texture pixel coordinates to world coordinates.
+ *    hull2:      The second hull.
+ *    transform2: Maps hull2's texture pixel coordinates to world coordinates.
+ *
+ *  Returns:
+ *    True if the transformed polygons overlap.
+ */
+bool CollisionHull::overlap(const CollisionHull& hull1, const sf::Transform& transform1,
+    const CollisionHull& hull2, const sf::Transform& transform2) {
+
+    if (hull1.empty() || hull2.empty()) {
+        return false;
+    }
+
+    sf::Vector2f world1[MAX_VERTICES];
+    sf::Vector2f world2[MAX_VERTICES];
+
+    for (std::size_t i = 0; i < hull1.vertexCount; ++i) {
+        world1[i] = transform1.transformPoint(hull1.vertices[i]);
+    }
+
+    for (std::size_t i = 0; i < hull2.vertexCount; ++i) {
+        world2[i] = transform2.transformPoint(hull2.vertices[i]);
+    }
+
+    return !hasSeparatingAxis(world1, hull1.vertexCount, world2, hull2.vertexCount) &&
+        !hasSeparatingAxis(world2, hull2.vertexCount, world1, hull1.vertexCount);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include "CollisionMask.h"
+
+/*
+ *  Simplified convex outline of a texture's solid pixels, in texture pixel coordinates.
+ *  Built once at load time from the texture's CollisionMask so two Mobs can be tested
+ *  with a few-vertex separating axis test instead of comparing masks.
+ */
+class CollisionHull {
+public:
+    static constexpr std::size_t MAX_VERTICES = 12;
+
+    CollisionHull();
+    explicit CollisionHull(const CollisionMask& mask, std::size_t maxVertices = 8);
+
+    std::size_t getVertexCount() const;
+    const sf::Vector2f& getVertex(std::size_t index) const;
+    bool empty() const;
+
+    static bool overlap(const CollisionHull& hull1, const sf::Transform& transform1,
+        const CollisionHull& hull2, const sf::Transform& transform2);
+
+private:
+    sf::Vector2f vertices[MAX_VERTICES];
+    std::size_t vertexCount;
+};
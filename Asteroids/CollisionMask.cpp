@@ -0,0 +1,297 @@
+#include "CollisionMask.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    /*
+     *  Returns the 64 bits of a packed row starting at bitOffset, which may be negative
+     *  or run past the end of the row. Bits outside the row read as zero.
+     */
+    std::uint64_t extractBits(const std::uint64_t* row, unsigned int words, int bitOffset) {
+        int word = bitOffset >= 0 ? bitOffset / 64 : -((-bitOffset + 63) / 64);
+        int shift = bitOffset - word * 64;
+
+        std::uint64_t low = (word >= 0 && word < static_cast<int>(words)) ? row[word] : 0;
+        if (shift == 0) {
+            return low;
+        }
+
+        std::uint64_t high = (word + 1 >= 0 && word + 1 < static_cast<int>(words)) ? row[word + 1] : 0;
+        return (low >> shift) | (high << (64 - shift));
+    }
+
+    /*
+     *  Returns true if any bit is set in both rows, a 64-bit word at a time.
+     */
+    bool rowsIntersect(const std::uint64_t* row1, const std::uint64_t* row2, unsigned int words) {
+        for (unsigned int i = 0; i < words; ++i) {
+            if (row1[i] & row2[i]) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*
+     *  Narrows a range of x to where start + step * x lies in [0, limit). The bounds are
+     *  widened by a pixel to absorb rounding, so callers still check each sample.
+     */
+    void clipSpan(float start, float step, float limit, int& minX, int& maxX) {
+        if (std::fabs(step) < 1e-6f) {
+            if (start < 0.0f || start >= limit) {
+                maxX = minX;
+            }
+            return;
+        }
+
+        float first = -start / step;
+        float last = (limit - start) / step;
+        if (step < 0.0f) {
+            std::swap(first, last);
+        }
+
+        minX = std::max(minX, static_cast<int>(std::floor(first)) - 1);
+        maxX = std::min(maxX, static_cast<int>(std::ceil(last)) + 1);
+    }
+
+    /*
+     *  Reusable buffer for one row of the other mask, realigned to this mask's words.
+     *  It only ever grows, so steady-state collision checks do not allocate.
+     */
+    std::uint64_t* scratchRow(unsigned int words) {
+        static thread_local std::vector<std::uint64_t> scratch;
+        if (scratch.size() < words) {
+            scratch.resize(words);
+        }
+        return scratch.data();
+    }
+}
+
+CollisionMask::CollisionMask() : size(0, 0), wordsPerRow(0) {
+
+}
+
+/*
+ *  Builds the mask from an image, marking every pixel whose alpha is above
+ *  ALPHA_THRESHOLD as solid.
+ *
+ *  Parameters:
+ *    image: The image to take the alpha channel from.
+ */
+CollisionMask::CollisionMask(const sf::Image& image) : size(image.getSize()) {
+    wordsPerRow = (size.x + 63) / 64;
+    bits.assign(static_cast<std::size_t>(wordsPerRow) * size.y, 0);
+
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    if (pixels == nullptr) {
+        return;
+    }
+
+    for (unsigned int y = 0; y < size.y; ++y) {
+        std::uint64_t* row = &bits[static_cast<std::size_t>(y) * wordsPerRow];
+
+        for (unsigned int x = 0; x < size.x; ++x) {
+            // Pixels are stored as RGBA, so the alpha is the fourth byte
+            sf::Uint8 alpha = pixels[(static_cast<std::size_t>(y) * size.x + x) * 4 + 3];
+            if (alpha > ALPHA_THRESHOLD) {
+                row[x / 64] |= std::uint64_t(1) << (x % 64);
+            }
+        }
+    }
+}
+
+/*
+ *  Returns true if the pixel at (x, y) is opaque enough to collide with.
+ *  Coordinates outside the mask are treated as empty.
+ */
+bool CollisionMask::isSolid(unsigned int x, unsigned int y) const {
+    if (x >= size.x || y >= size.y) {
+        return false;
+    }
+
+    return (getRow(y)[x / 64] >> (x % 64)) & 1;
+}
+
+sf::Vector2u CollisionMask::getSize() const {
+    return size;
+}
+
+bool CollisionMask::empty() const {
+    return bits.empty();
+}
+
+unsigned int CollisionMask::getWordsPerRow() const {
+    return wordsPerRow;
+}
+
+const std::uint64_t* CollisionMask::getRow(unsigned int y) const {
+    return &bits[static_cast<std::size_t>(y) * wordsPerRow];
+}
+
+/*
+ *  Tests whether two masks placed in the world have any solid pixels in common.
+ *  The larger mask is walked row by row and the smaller one is realigned to its
+ *  words, so the work is bounded by the smaller mask's footprint.
+ *
+ *  Parameters:
+ *    mask1:      The first mask.
+ *    transform1: Maps mask1 pixel coordinates to world coordinates.
+ *    mask2:      The second mask.
+ *    transform2: Maps mask2 pixel coordinates to world coordinates.
+ *
+ *  Returns:
+ *    True if a solid pixel of one mask lands on a solid pixel of the other.
+ */
+bool CollisionMask::overlap(const CollisionMask& mask1, const sf::Transform& transform1,
+    const CollisionMask& mask2, const sf::Transform& transform2) {
+
+    if (mask1.empty() || mask2.empty()) {
+        return false;
+    }
+
+    bool mask1Larger = mask1.size.x * mask1.size.y >= mask2.size.x * mask2.size.y;
+    const CollisionMask& large = mask1Larger ? mask1 : mask2;
+    const CollisionMask& small = mask1Larger ? mask2 : mask1;
+    const sf::Transform& largeTransform = mask1Larger ? transform1 : transform2;
+    const sf::Transform& smallTransform = mask1Larger ? transform2 : transform1;
+
+    // Maps pixel coordinates of the large mask into pixel coordinates of the small mask
+    sf::Transform toSmall = smallTransform.getInverse();
+    toSmall.combine(largeTransform);
+
+    const float* m = toSmall.getMatrix();
+    const float epsilon = 1e-4f;
+    bool translationOnly = std::fabs(m[0] - 1.0f) < epsilon && std::fabs(m[5] - 1.0f) < epsilon &&
+        std::fabs(m[1]) < epsilon && std::fabs(m[4]) < epsilon;
+
+    if (translationOnly) {
+        int offsetX = static_cast<int>(std::floor(m[12] + 0.5f));
+        int offsetY = static_cast<int>(std::floor(m[13] + 0.5f));
+        return large.overlapTranslated(small, offsetX, offsetY);
+    }
+
+    return large.overlapTransformed(small, toSmall);
+}
+
+/*
+ *  Word-wide overlap test for masks that differ only by a whole-pixel translation.
+ *  Pixel (x, y) of this mask lines up with pixel (x + offsetX, y + offsetY) of other.
+ */
+bool CollisionMask::overlapTranslated(const CollisionMask& other, int offsetX, int offsetY) const {
+    int startX = std::max(0, -offsetX);
+    int endX = std::min(static_cast<int>(size.x), static_cast<int>(other.size.x) - offsetX);
+    int startY = std::max(0, -offsetY);
+    int endY = std::min(static_cast<int>(size.y), static_cast<int>(other.size.y) - offsetY);
+
+    if (startX >= endX || startY >= endY) {
+        return false;
+    }
+
+    unsigned int firstWord = static_cast<unsigned int>(startX) / 64;
+    unsigned int wordCount = static_cast<unsigned int>(endX - 1) / 64 - firstWord + 1;
+    std::uint64_t* shifted = scratchRow(wordCount);
+
+    for (int y = startY; y < endY; ++y) {
+        const std::uint64_t* otherRow = other.getRow(static_cast<unsigned int>(y + offsetY));
+
+        // Bits outside either row read as zero, so no edge masking is needed
+        for (unsigned int i = 0; i < wordCount; ++i) {
+            int bitOffset = static_cast<int>((firstWord + i) * 64) + offsetX;
+            shifted[i] = extractBits(otherRow, other.wordsPerRow, bitOffset);
+        }
+
+        if (rowsIntersect(getRow(static_cast<unsigned int>(y)) + firstWord, shifted, wordCount)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ *  Overlap test for masks related by rotation or scale. Each row of this mask inside the
+ *  other mask's footprint is matched 64 pixels at a time: for every word of the row with
+ *  solid bits, the other mask is resampled into a packed word (stepping the affine
+ *  transform incrementally and reading its words directly) and the two are ANDed. Empty
+ *  words are skipped without sampling, and each row is clipped to the span whose samples
+ *  land inside the other mask.
+ *
+ *  Parameters:
+ *    other:   The mask to test against.
+ *    toOther: Maps pixel coordinates of this mask into pixel coordinates of other.
+ */
+bool CollisionMask::overlapTransformed(const CollisionMask& other, const sf::Transform& toOther) const {
+    sf::FloatRect footprint = toOther.getInverse().transformRect(
+        sf::FloatRect(0.0f, 0.0f, static_cast<float>(other.size.x), static_cast<float>(other.size.y)));
+
+    int startX = std::max(0, static_cast<int>(std::floor(footprint.left)));
+    int endX = std::min(static_cast<int>(size.x), static_cast<int>(std::ceil(footprint.left + footprint.width)));
+    int startY = std::max(0, static_cast<int>(std::floor(footprint.top)));
+    int endY = std::min(static_cast<int>(size.y), static_cast<int>(std::ceil(footprint.top + footprint.height)));
+
+    if (startX >= endX || startY >= endY) {
+        return false;
+    }
+
+    const float* m = toOther.getMatrix();
+    const float stepX = m[0];
+    const float stepY = m[1];
+    const float otherWidth = static_cast<float>(other.size.x);
+    const float otherHeight = static_cast<float>(other.size.y);
+
+    for (int y = startY; y < endY; ++y) {
+        const std::uint64_t* row = getRow(static_cast<unsigned int>(y));
+
+        // Sample at pixel centres: u and v at x = 0, then clip to where both are inside other
+        float centreY = y + 0.5f;
+        float rowU = m[0] * 0.5f + m[4] * centreY + m[12];
+        float rowV = m[1] * 0.5f + m[5] * centreY + m[13];
+
+        int minX = startX;
+        int maxX = endX;
+        clipSpan(rowU, stepX, otherWidth, minX, maxX);
+        clipSpan(rowV, stepY, otherHeight, minX, maxX);
+        maxX = std::min(maxX, endX);
+
+        if (minX >= maxX) {
+            continue;
+        }
+
+        for (unsigned int word = static_cast<unsigned int>(minX) / 64; word <= static_cast<unsigned int>(maxX - 1) / 64; ++word) {
+            int wordStart = std::max(minX, static_cast<int>(word * 64));
+            int wordEnd = std::min(maxX, static_cast<int>(word * 64) + 64);
+
+            // Only the bits of the span count
+            std::uint64_t bits = row[word];
+            int low = wordStart - static_cast<int>(word * 64);
+            int high = wordEnd - static_cast<int>(word * 64);
+            bits &= ~std::uint64_t(0) << low;
+            if (high < 64) {
+                bits &= (std::uint64_t(1) << high) - 1;
+            }
+            if (bits == 0) {
+                continue;
+            }
+
+            std::uint64_t resampled = 0;
+            float u = rowU + stepX * wordStart;
+            float v = rowV + stepY * wordStart;
+
+            for (int bit = low; bit < high; ++bit, u += stepX, v += stepY) {
+                if (u >= 0.0f && v >= 0.0f && u < otherWidth && v < otherHeight) {
+                    unsigned int otherX = static_cast<unsigned int>(u);
+                    const std::uint64_t* otherRow = other.getRow(static_cast<unsigned int>(v));
+                    resampled |= ((otherRow[otherX / 64] >> (otherX % 64)) & 1) << bit;
+                }
+            }
+
+            if (bits & resampled) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+/*
+ *  CPU-side copy of a texture's alpha channel, reduced to solid/empty per pixel.
+ *  Built once when a texture is loaded so collision checks never need to read
+ *  the texture back from the GPU.
+ *
+ *  Each row is packed one bit per pixel into 64-bit words (pixel x lives in bit
+ *  x % 64 of word x / 64), so overlap tests can AND whole words at a time.
+ *  Padding bits past the row width are always zero.
+ */
+class CollisionMask {
+public:
+    static const sf::Uint8 ALPHA_THRESHOLD = 50;
+
+    CollisionMask();
+    explicit CollisionMask(const sf::Image& image);
+
+    bool isSolid(unsigned int x, unsigned int y) const;
+    sf::Vector2u getSize() const;
+    bool empty() const;
+    unsigned int getWordsPerRow() const;
+    const std::uint64_t* getRow(unsigned int y) const;
+
+    static bool overlap(const CollisionMask& mask1, const sf::Transform& transform1,
+        const CollisionMask& mask2, const sf::Transform& transform2);
+
+private:
+    bool overlapTranslated(const CollisionMask& other, int offsetX, int offsetY) const;
+    bool overlapTransformed(const CollisionMask& other, const sf::Transform& toOther) const;
+
+    sf::Vector2u size;
+    unsigned int wordsPerRow;
+    std::vector<std::uint64_t> bits;
+};
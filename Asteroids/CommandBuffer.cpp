@@ -0,0 +1,79 @@
+#include "CommandBuffer.h"
+
+/*
+ *  Parameters:
+ *    store:     The store the requests are applied to.
+ *    keepOrder: True to remove destroyed entities with EntityStore::remove, keeping the
+ *               survivors in order, false to use the constant time removeUnordered.
+ *    resource:  Where pending requests are kept until they are flushed.
+ */
+CommandBuffer::CommandBuffer(EntityStore& store, bool keepOrder, std::pmr::memory_resource* resource)
+    : store(&store), keepOrder(keepOrder), pending(store.getType(), resource), destroyed(resource) {
+
+}
+
+/*
+ *  Returns the staging store new entities are added to. Indices into it are only
+ *  meaningful until the next flush.
+ */
+EntityStore& CommandBuffer::spawns() {
+    return pending;
+}
+
+/*
+ *  Returns true if the store has a capacity and the entities already in it plus those
+ *  waiting to spawn fill it. Destroy requests are not counted, so this errs on the side
+ *  of refusing a spawn rather than dropping one at flush.
+ */
+bool CommandBuffer::full() const {
+    return store->capacity() != 0 && store->size() + pending.size() >= store->capacity();
+}
+
+/*
+ *  Marks an entity in the store for removal at the next flush. Marking it twice is harmless.
+ */
+void CommandBuffer::destroy(std::size_t index) {
+    if (destroyed.size() < store->size()) {
+        destroyed.resize(store->size(), false);
+    }
+
+    destroyed[index] = true;
+    anyDestroyed = true;
+}
+
+bool CommandBuffer::isDestroyed(std::size_t index) const {
+    return index < destroyed.size() && destroyed[index];
+}
+
+/*
+ *  Applies every request made since the last flush: destroyed entities are removed
+ *  first, while their indices still refer to the right entities, then the spawns are
+ *  appended. Only a capped store can turn spawns away here; its systems check full
+ *  before spawning, which counts conservatively, so in practice none are.
+ */
+void CommandBuffer::flush() {
+    if (anyDestroyed) {
+        if (keepOrder) {
+            store->remove(destroyed);
+        }
+        else {
+            store->removeUnordered(destroyed);
+        }
+    }
+
+    if (!pending.empty()) {
+        store->append(pending);
+    }
+
+    clear();
+}
+
+/*
+ *  Drops every request made since the last flush without applying it, and hands the
+ *  memory they used back to the buffer's resource.
+ */
+void CommandBuffer::clear() {
+    pending.release();
+    std::pmr::vector<bool>(destroyed.get_allocator()).swap(destroyed);
+    anyDestroyed = false;
+}
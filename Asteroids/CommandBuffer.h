@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include "EntityStore.h"
+
+/*
+ *  Spawn and destroy requests for one EntityStore, gathered while a tick runs and applied
+ *  together by flush at the end of it. Until then the store itself is left alone, so
+ *  indices handed out by a broadphase or held by a loop stay valid for the whole tick.
+ *
+ *  New entities are built in a staging store returned by spawns(), with every column
+ *  available to set, and are appended to the real store in one go; they get their handles
+ *  when they are flushed.
+ *
+ *  The staging store and destroy flags only hold anything between a request and the next
+ *  flush or clear, which give their memory back, so they can come from a FrameArena.
+ */
+class CommandBuffer {
+public:
+    CommandBuffer(EntityStore& store, bool keepOrder, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    EntityStore& spawns();
+    bool full() const;
+
+    void destroy(std::size_t index);
+    bool isDestroyed(std::size_t index) const;
+
+    void flush();
+    void clear();
+
+private:
+    EntityStore* store;
+    bool keepOrder;
+    EntityStore pending;
+    std::pmr::vector<bool> destroyed;
+    bool anyDestroyed = false;
+};
@@ -0,0 +1,83 @@
+#include "EnemyShipSystem.h"
+#include <cmath>
+
+EnemyShipSystem::EnemyShipSystem(TextureManager& textureManager, ProjectileSystem& projectileSystem)
+    : textureManager(&textureManager), projectileSystem(&projectileSystem) {
+
+    texture = textureManager.getHandle("EnemyShip");
+    projectileTexture = textureManager.getHandle("Laser");
+}
+
+/*
+ *  Adds a motionless enemy ship at the origin, for the caller to place.
+ *
+ *  Returns:
+ *    The new ship's index.
+ */
+std::size_t EnemyShipSystem::spawn(EntityStore& store) {
+    sf::Vector2u size = textureManager->getTextureSize(texture);
+
+    return store.add(texture, sf::Vector2f(static_cast<float>(size.x), static_cast<float>(size.y)),
+        sf::Vector2f(0.0f, 0.0f), sf::Vector2f(0.0f, 0.0f), 0.0f);
+}
+
+/*
+ *  Updates every enemy ship's position and firing behavior.
+ *  Parameters:
+ *    store:              The store holding the ships.
+ *    projectileCommands: The projectile store's command buffer, which shots are requested from.
+ *    deltaTime:          Time elapsed since the last update cycle.
+ *    targetPosition:     Position of the target.
+ */
+void EnemyShipSystem::update(EntityStore& store, CommandBuffer& projectileCommands, sf::Time deltaTime, const sf::Vector2f& targetPosition) {
+    const sf::Time fireRate = sf::seconds(static_cast<float>(fireRateInSeconds));
+
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        store.position[i] += store.velocity[i] * deltaTime.asSeconds();
+
+        store.fireTimer[i] += deltaTime;
+
+        if (store.fireTimer[i] >= fireRate) {
+            fire(store, i, projectileCommands, targetPosition);
+            store.fireTimer[i] = sf::Time::Zero;
+        }
+    }
+}
+
+/*
+ *  Fires a projectile from an enemy ship towards the specified target position.
+ *  Parameters:
+ *    store:              The store holding the ship.
+ *    index:              The ship that fires.
+ *    projectileCommands: The projectile store's command buffer.
+ *    targetPosition:     The position towards which the projectile should be fired, normally the player.
+ */
+void EnemyShipSystem::fire(EntityStore& store, std::size_t index, CommandBuffer& projectileCommands, const sf::Vector2f& targetPosition) {
+    sf::Vector2f position = store.position[index];
+    sf::Vector2f direction = targetPosition - position;
+
+
+    // Normalise the direction vector
+    float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (distance > 0) {
+        direction /= distance;
+    }
+
+
+    float rotation = std::atan2(direction.y, direction.x) * (180.0f / 3.14159265f) + 90;
+
+    std::size_t projectile = projectileSystem->fire(projectileCommands, projectileTexture, position, direction, rotation, projectileSpeed);
+
+    if (projectile == EntityStore::npos) {
+        return;
+    }
+
+    EntityStore& projectiles = projectileCommands.spawns();
+
+    if (store.wraps[index]) {
+        projectiles.setWraps(projectile);
+    }
+
+    //Allows it to collide with the player
+    projectiles.hostile[projectile] = 1;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "CommandBuffer.h"
+#include "EntityStore.h"
+#include "ProjectileSystem.h"
+#include "TextureManager.h"
+
+/*
+ *  Enemy ship behaviour over an EntityStore of enemy ships: drifting in a straight
+ *  line and firing at a target, normally the player, at a fixed rate.
+ */
+class EnemyShipSystem {
+public:
+    EnemyShipSystem(TextureManager& textureManager, ProjectileSystem& projectileSystem);
+
+    std::size_t spawn(EntityStore& store);
+    void update(EntityStore& store, CommandBuffer& projectileCommands, sf::Time deltaTime, const sf::Vector2f& targetPosition);
+
+    float projectileSpeed = 400.0f;
+    double fireRateInSeconds = 2.0;
+
+private:
+    void fire(EntityStore& store, std::size_t index, CommandBuffer& projectileCommands, const sf::Vector2f& targetPosition);
+
+    TextureManager* textureManager;
+    ProjectileSystem* projectileSystem;
+    TextureManager::Handle texture;
+    TextureManager::Handle projectileTexture;
+};
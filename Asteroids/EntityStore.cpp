@@ -0,0 +1,382 @@
+#include "EntityStore.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace {
+
+    /*
+     *  Moves the elements not flagged in removed to the front of a column, keeping their
+     *  order, and drops the rest. Elements past the end of removed are kept.
+     */
+    template <typename T>
+    void compact(std::pmr::vector<T>& column, const std::pmr::vector<bool>& removed) {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < column.size(); ++i) {
+            if (i < removed.size() && removed[i]) {
+                continue;
+            }
+            if (kept != i) {
+                column[kept] = column[i];
+            }
+            ++kept;
+        }
+        column.resize(kept);
+    }
+
+    /*
+     *  Moves the last element of a column into index and drops the last element.
+     */
+    template <typename T>
+    void swapAndPop(std::pmr::vector<T>& column, std::size_t index) {
+        if (index + 1 != column.size()) {
+            column[index] = column.back();
+        }
+        column.pop_back();
+    }
+}
+
+/*
+ *  Parameters:
+ *    type:     The type of entity the store holds, which decides the columns it uses.
+ *    resource: Where every column and the slot table allocate from.
+ */
+EntityStore::EntityStore(Type type, std::pmr::memory_resource* resource)
+    : handle(resource), texture(resource), extent(resource), position(resource), velocity(resource),
+    rotation(resource), solid(resource), wraps(resource), asteroidSize(resource), fireTimer(resource),
+    previousPosition(resource), target(resource), targetType(resource), hostile(resource),
+    type(type), maxSize(0), slotIndex(resource), slotGeneration(resource), freeSlots(resource) {
+
+}
+
+/*
+ *  Calls function on every column entities of the store's type use, including the
+ *  handle column but not the slot table. Store is EntityStore or const EntityStore.
+ */
+template <typename Store, typename Function>
+void EntityStore::forEachColumn(Store& store, Function function) {
+    function(store.handle);
+    function(store.texture);
+    function(store.extent);
+    function(store.position);
+    function(store.velocity);
+    function(store.rotation);
+    function(store.solid);
+    function(store.wraps);
+
+    switch (store.type) {
+    case Type::Asteroid:
+        function(store.asteroidSize);
+        break;
+    case Type::EnemyShip:
+        function(store.fireTimer);
+        break;
+    case Type::Projectile:
+        function(store.previousPosition);
+        function(store.target);
+        function(store.targetType);
+        function(store.hostile);
+        break;
+    case Type::Player:
+        break;
+    }
+}
+
+EntityStore::Type EntityStore::getType() const {
+    return type;
+}
+
+/*
+ *  Caps the store at a fixed number of entities and allocates every column up front,
+ *  so adding and removing entities never reallocates. Once the store is full, add
+ *  refuses new entities until some are removed. A capacity of 0 removes the cap.
+ */
+void EntityStore::setCapacity(std::size_t capacity) {
+    maxSize = capacity;
+    reserve(capacity);
+}
+
+std::size_t EntityStore::capacity() const {
+    return maxSize;
+}
+
+/*
+ *  Allocates every column for at least count entities without capping the store, so it
+ *  only reallocates once it grows past that.
+ */
+void EntityStore::reserve(std::size_t count) {
+    forEachColumn(*this, [count](auto& column) { column.reserve(count); });
+    slotIndex.reserve(count);
+    slotGeneration.reserve(count);
+    freeSlots.reserve(count);
+}
+
+/*
+ *  Returns how many entities the store has room for before it next reallocates.
+ */
+std::size_t EntityStore::reserved() const {
+    return handle.capacity();
+}
+
+bool EntityStore::full() const {
+    return maxSize != 0 && handle.size() >= maxSize;
+}
+
+/*
+ *  Returns how many bytes each entity in this store takes up: one element of every
+ *  column its type uses plus its entry in the slot table. Spare vector capacity and
+ *  the free list are not counted.
+ */
+std::size_t EntityStore::bytesPerEntity() const {
+    std::size_t bytes = sizeof(std::uint32_t) * 2;
+
+    forEachColumn(*this, [&bytes](const auto& column) {
+        bytes += sizeof(typename std::decay<decltype(column)>::type::value_type);
+    });
+
+    return bytes;
+}
+
+/*
+ *  Appends an entity. Columns not given here start at their defaults: solid and not
+ *  wrapping, and for the store's type a small asteroid, a fresh fire timer, or a
+ *  friendly projectile with no target.
+ *
+ *  Parameters:
+ *    texture:  The texture to draw and collide it with.
+ *    size:     The texture's size in pixels; the entity rotates about its centre.
+ *    position: Where its centre starts.
+ *    velocity: Its starting velocity in units per second.
+ *    rotation: Its starting rotation in degrees.
+ *
+ *  Returns:
+ *    The new entity's index, or npos if the store is full.
+ */
+std::size_t EntityStore::add(TextureManager::Handle texture, const sf::Vector2f& size,
+    const sf::Vector2f& position, const sf::Vector2f& velocity, float rotation) {
+
+    if (full()) {
+        return npos;
+    }
+
+    handle.push_back(allocateHandle(handle.size()));
+    this->texture.push_back(texture);
+    extent.push_back(size);
+    this->position.push_back(position);
+    this->velocity.push_back(velocity);
+    this->rotation.push_back(rotation);
+    solid.push_back(1);
+    wraps.push_back(0);
+
+    switch (type) {
+    case Type::Asteroid:
+        asteroidSize.push_back(0);
+        break;
+    case Type::EnemyShip:
+        fireTimer.push_back(sf::Time::Zero);
+        break;
+    case Type::Projectile:
+        previousPosition.push_back(position);
+        target.push_back(Handle());
+        targetType.push_back(Type::Asteroid);
+        hostile.push_back(0);
+        break;
+    case Type::Player:
+        break;
+    }
+
+    return handle.size() - 1;
+}
+
+/*
+ *  Appends every entity of another store of the same type, in order, with new handles
+ *  from this one. Stops once this store is full.
+ */
+void EntityStore::append(const EntityStore& other) {
+    for (std::size_t i = 0; i < other.size() && !full(); ++i) {
+        handle.push_back(allocateHandle(handle.size()));
+        texture.push_back(other.texture[i]);
+        extent.push_back(other.extent[i]);
+        position.push_back(other.position[i]);
+        velocity.push_back(other.velocity[i]);
+        rotation.push_back(other.rotation[i]);
+        solid.push_back(other.solid[i]);
+        wraps.push_back(other.wraps[i]);
+
+        switch (type) {
+        case Type::Asteroid:
+            asteroidSize.push_back(other.asteroidSize[i]);
+            break;
+        case Type::EnemyShip:
+            fireTimer.push_back(other.fireTimer[i]);
+            break;
+        case Type::Projectile:
+            previousPosition.push_back(other.previousPosition[i]);
+            target.push_back(other.target[i]);
+            targetType.push_back(other.targetType[i]);
+            hostile.push_back(other.hostile[i]);
+            break;
+        case Type::Player:
+            break;
+        }
+    }
+}
+
+/*
+ *  Removes every entity flagged in removed, keeping the survivors in order.
+ *  Entities added after removed was sized are kept.
+ */
+void EntityStore::remove(const std::pmr::vector<bool>& removed) {
+    for (std::size_t i = 0; i < removed.size() && i < handle.size(); ++i) {
+        if (removed[i]) {
+            releaseHandle(handle[i]);
+        }
+    }
+
+    forEachColumn(*this, [&removed](auto& column) { compact(column, removed); });
+
+    for (std::size_t i = 0; i < handle.size(); ++i) {
+        slotIndex[handle[i].slot] = static_cast<std::uint32_t>(i);
+    }
+}
+
+/*
+ *  Removes every entity flagged in removed in O(1) each, by moving the last entity
+ *  into the removed one's slot. Survivors do not keep their order, so this suits
+ *  stores where nothing depends on it, such as projectiles. Entities added after
+ *  removed was sized are kept.
+ */
+void EntityStore::removeUnordered(const std::pmr::vector<bool>& removed) {
+
+    // Walking backwards means every entity moved into a slot has already been checked
+    for (std::size_t i = std::min(removed.size(), handle.size()); i-- > 0;) {
+        if (!removed[i]) {
+            continue;
+        }
+
+        releaseHandle(handle[i]);
+
+        forEachColumn(*this, [i](auto& column) { swapAndPop(column, i); });
+
+        if (i < handle.size()) {
+            slotIndex[handle[i].slot] = static_cast<std::uint32_t>(i);
+        }
+    }
+}
+
+void EntityStore::clear() {
+    for (const Handle& entity : handle) {
+        releaseHandle(entity);
+    }
+
+    forEachColumn(*this, [](auto& column) { column.clear(); });
+}
+
+/*
+ *  Empties the store and hands every column's and the slot table's memory back to the
+ *  store's resource, without touching the elements. A store living in a FrameArena must
+ *  be released before the arena is reset; handles it gave out are forgotten, not bumped.
+ */
+void EntityStore::release() {
+    auto releaseColumn = [](auto& column) {
+        typename std::decay<decltype(column)>::type(column.get_allocator()).swap(column);
+    };
+
+    forEachColumn(*this, releaseColumn);
+    releaseColumn(slotIndex);
+    releaseColumn(slotGeneration);
+    releaseColumn(freeSlots);
+}
+
+std::size_t EntityStore::size() const {
+    return handle.size();
+}
+
+bool EntityStore::empty() const {
+    return handle.empty();
+}
+
+/*
+ *  Returns the index of the entity a handle refers to, or npos if the handle is null
+ *  or the entity has been removed.
+ */
+std::size_t EntityStore::find(Handle entity) const {
+    if (entity.isNull() || entity.slot >= slotGeneration.size() || slotGeneration[entity.slot] != entity.generation) {
+        return npos;
+    }
+
+    return slotIndex[entity.slot];
+}
+
+/*
+ *  Takes a slot from the free list, or a new one, and points it at index.
+ */
+EntityStore::Handle EntityStore::allocateHandle(std::size_t index) {
+    Handle entity;
+
+    if (!freeSlots.empty()) {
+        entity.slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        entity.slot = static_cast<std::uint32_t>(slotGeneration.size());
+        slotIndex.push_back(0);
+        slotGeneration.push_back(1);
+    }
+
+    entity.generation = slotGeneration[entity.slot];
+    slotIndex[entity.slot] = static_cast<std::uint32_t>(index);
+    return entity;
+}
+
+/*
+ *  Invalidates every copy of a handle and returns its slot to the free list.
+ */
+void EntityStore::releaseHandle(Handle entity) {
+    std::uint32_t& generation = slotGeneration[entity.slot];
+
+    // Generation 0 is reserved for null handles
+    if (++generation == 0) {
+        generation = 1;
+    }
+
+    freeSlots.push_back(entity.slot);
+}
+
+void EntityStore::setTexture(std::size_t index, TextureManager::Handle texture, const sf::Vector2f& size) {
+    this->texture[index] = texture;
+    extent[index] = size;
+}
+
+/*
+ *  Makes an entity wrap around the edges of the world (see World).
+ */
+void EntityStore::setWraps(std::size_t index) {
+    wraps[index] = 1;
+}
+
+/*
+ *  Returns the transform from an entity's texture pixel coordinates to world
+ *  coordinates: rotated about the texture's centre, which sits at the entity's
+ *  position. Matches what sf::Transformable builds for a sprite with its origin
+ *  at the centre.
+ */
+sf::Transform EntityStore::getTransform(std::size_t index) const {
+    sf::Vector2f origin = extent[index] / 2.0f;
+    float angle = -rotation[index] * 3.14159265f / 180.0f;
+    float cosine = static_cast<float>(std::cos(angle));
+    float sine = static_cast<float>(std::sin(angle));
+    float tx = -origin.x * cosine - origin.y * sine + position[index].x;
+    float ty = origin.x * sine - origin.y * cosine + position[index].y;
+
+    return sf::Transform(cosine, sine, tx,
+        -sine, cosine, ty,
+        0.0f, 0.0f, 1.0f);
+}
+
+/*
+ *  Returns the axis-aligned bounds of an entity in world coordinates.
+ */
+sf::FloatRect EntityStore::getBounds(std::size_t index) const {
+    return getTransform(index).transformRect(sf::FloatRect(0.0f, 0.0f, extent[index].x, extent[index].y));
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "TextureManager.h"
+
+/*
+ *  Structure-of-arrays storage for game entities of one type. Each entity is an index
+ *  into a set of parallel columns, so a system that only needs positions and velocities
+ *  streams through those two arrays instead of chasing pointers to whole sprites.
+ *
+ *  Entities carry a texture handle and their size rather than an sf::Sprite; the
+ *  renderer builds whatever it draws, including wrapped copies, from the columns. The
+ *  per-type columns at the end are only filled in stores of that type and stay empty
+ *  in the others, so every entity pays only for the columns its type uses (see
+ *  bytesPerEntity).
+ *
+ *  Indices are only stable until the next remove. Anything that has to refer to an
+ *  entity across updates keeps its Handle and resolves it with find, in constant time.
+ *  A handle names a slot in a lookup table plus the slot's generation; removing an
+ *  entity bumps its slot's generation, so old handles resolve to npos even once the
+ *  slot is reused.
+ *
+ *  Columns draw their memory from the resource given at construction, so a short-lived
+ *  store, such as a CommandBuffer's staging store, can live in a FrameArena.
+ */
+class EntityStore {
+public:
+    enum class Type : std::uint8_t { Asteroid, EnemyShip, Projectile, Player };
+
+    // A default constructed handle (generation 0) refers to no entity
+    struct Handle {
+        std::uint32_t slot = 0;
+        std::uint32_t generation = 0;
+
+        bool isNull() const { return generation == 0; }
+        bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit EntityStore(Type type, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    Type getType() const;
+    void setCapacity(std::size_t capacity);
+    std::size_t capacity() const;
+    void reserve(std::size_t count);
+    std::size_t reserved() const;
+    bool full() const;
+    std::size_t bytesPerEntity() const;
+
+    std::size_t add(TextureManager::Handle texture, const sf::Vector2f& size,
+        const sf::Vector2f& position, const sf::Vector2f& velocity, float rotation);
+    void append(const EntityStore& other);
+    void remove(const std::pmr::vector<bool>& removed);
+    void removeUnordered(const std::pmr::vector<bool>& removed);
+    void clear();
+    void release();
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t find(Handle handle) const;
+
+    void setTexture(std::size_t index, TextureManager::Handle texture, const sf::Vector2f& size);
+    void setWraps(std::size_t index);
+    sf::Transform getTransform(std::size_t index) const;
+    sf::FloatRect getBounds(std::size_t index) const;
+
+    std::pmr::vector<Handle> handle;
+    std::pmr::vector<TextureManager::Handle> texture;
+    std::pmr::vector<sf::Vector2f> extent; // Texture size in pixels
+    std::pmr::vector<sf::Vector2f> position;
+    std::pmr::vector<sf::Vector2f> velocity;
+    std::pmr::vector<float> rotation;
+    std::pmr::vector<std::uint8_t> solid;
+
+    // Set once an entity should wrap around the edges of the world
+    std::pmr::vector<std::uint8_t> wraps;
+
+    // Asteroid: 2 (large), 1 (medium) or 0 (small)
+    std::pmr::vector<std::uint8_t> asteroidSize;
+
+    // EnemyShip: time since the ship last fired
+    std::pmr::vector<sf::Time> fireTimer;
+
+    // Projectile: where it was before its last move, the entity it is homing in on and
+    // the type of store that lives in, and whether it was fired at the player
+    std::pmr::vector<sf::Vector2f> previousPosition;
+    std::pmr::vector<Handle> target;
+    std::pmr::vector<Type> targetType;
+    std::pmr::vector<std::uint8_t> hostile;
+
+private:
+    Type type;
+    std::size_t maxSize;
+
+    // Lookup table indexed by Handle::slot
+    std::pmr::vector<std::uint32_t> slotIndex;
+    std::pmr::vector<std::uint32_t> slotGeneration;
+    std::pmr::vector<std::uint32_t> freeSlots;
+
+    template <typename Store, typename Function>
+    static void forEachColumn(Store& store, Function function);
+
+    Handle allocateHandle(std::size_t index);
+    void releaseHandle(Handle handle);
+};
@@ -0,0 +1,114 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <memory>
+#include <new>
+
+/*
+ *  Parameters:
+ *    capacity: Size in bytes of the block allocated up front.
+ *    upstream: Where the block and any overflow come from.
+ */
+FrameArena::FrameArena(std::size_t capacity, std::pmr::memory_resource* upstream)
+    : upstream(upstream), block(nullptr), blockSize(capacity), offset(0), overflowBytes(0), peakBytes(0), overflow(nullptr) {
+
+    if (blockSize > 0) {
+        block = static_cast<char*>(upstream->allocate(blockSize, alignof(std::max_align_t)));
+    }
+}
+
+FrameArena::~FrameArena() {
+    releaseOverflow();
+
+    if (block != nullptr) {
+        upstream->deallocate(block, blockSize, alignof(std::max_align_t));
+    }
+}
+
+/*
+ *  Makes the whole arena available again. If the tick that just ended overflowed, the
+ *  block is first regrown to hold everything it asked for.
+ */
+void FrameArena::reset() {
+    std::size_t needed = offset + overflowBytes;
+    releaseOverflow();
+
+    if (needed > blockSize) {
+        if (block != nullptr) {
+            upstream->deallocate(block, blockSize, alignof(std::max_align_t));
+        }
+
+        blockSize = needed;
+        block = static_cast<char*>(upstream->allocate(blockSize, alignof(std::max_align_t)));
+    }
+
+    offset = 0;
+}
+
+/*
+ *  Returns the bytes handed out since the last reset, including overflow.
+ */
+std::size_t FrameArena::used() const {
+    return offset + overflowBytes;
+}
+
+std::size_t FrameArena::capacity() const {
+    return blockSize;
+}
+
+/*
+ *  Returns the most bytes handed out between two resets so far.
+ */
+std::size_t FrameArena::peak() const {
+    return std::max(peakBytes, used());
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (block != nullptr) {
+        void* pointer = block + offset;
+        std::size_t space = blockSize - offset;
+
+        if (std::align(alignment, bytes, pointer, space) != nullptr) {
+            offset = static_cast<std::size_t>(static_cast<char*>(pointer) - block) + bytes;
+            peakBytes = std::max(peakBytes, used());
+            return pointer;
+        }
+    }
+
+    // Out of room: take it from upstream, with a header in front so reset can free it
+    std::size_t blockAlignment = std::max(alignment, alignof(Overflow));
+    std::size_t headerSize = (sizeof(Overflow) + blockAlignment - 1) / blockAlignment * blockAlignment;
+    char* memory = static_cast<char*>(upstream->allocate(headerSize + bytes, blockAlignment));
+
+    Overflow* header = new (memory) Overflow{ overflow, headerSize + bytes, blockAlignment };
+    overflow = header;
+
+    // Counted with the alignment padding a bump allocation might have needed
+    overflowBytes += bytes + alignment;
+    peakBytes = std::max(peakBytes, used());
+
+    return memory + headerSize;
+}
+
+/*
+ *  Memory is only given back by reset.
+ */
+void FrameArena::do_deallocate(void*, std::size_t, std::size_t) {
+
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+/*
+ *  Frees every allocation that came from upstream since the last reset.
+ */
+void FrameArena::releaseOverflow() {
+    while (overflow != nullptr) {
+        Overflow* next = overflow->next;
+        upstream->deallocate(overflow, overflow->bytes, overflow->alignment);
+        overflow = next;
+    }
+
+    overflowBytes = 0;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+/*
+ *  Linear allocator for data that only lives for one simulation tick. Allocating bumps
+ *  an offset into a single block, deallocating does nothing, and reset() makes the
+ *  whole block available again in one step.
+ *
+ *  If a tick needs more than the block holds, the excess comes from the upstream
+ *  resource and is freed at the next reset, which also grows the block to the peak
+ *  seen, so the arena settles at the largest tick's needs and stops touching the heap.
+ *
+ *  Everything allocated from the arena must be finished with before reset is called.
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    explicit FrameArena(std::size_t capacity, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void reset();
+    std::size_t used() const;
+    std::size_t capacity() const;
+    std::size_t peak() const;
+
+private:
+    // Header in front of every allocation served by upstream
+    struct Overflow {
+        Overflow* next;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void releaseOverflow();
+
+    std::pmr::memory_resource* upstream;
+    char* block;
+    std::size_t blockSize;
+    std::size_t offset;
+    std::size_t overflowBytes;
+    std::size_t peakBytes;
+    Overflow* overflow;
+};
@@ -0,0 +1,62 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+
+/*
+ *  Parameters:
+ *    windowSize: How many of the most recent samples are kept. At least 1.
+ */
+FrameStats::FrameStats(std::size_t windowSize) : samples(std::max<std::size_t>(windowSize, 1), 0), next(0), count(0) {
+    sorted.reserve(samples.size());
+}
+
+/*
+ *  Adds a sample, replacing the oldest once the window is full.
+ */
+void FrameStats::add(sf::Time sample) {
+    samples[next] = sample.asMicroseconds();
+    next = (next + 1) % samples.size();
+    count = std::min(count + 1, samples.size());
+}
+
+void FrameStats::clear() {
+    next = 0;
+    count = 0;
+}
+
+std::size_t FrameStats::size() const {
+    return count;
+}
+
+/*
+ *  Returns the nearest-rank percentile of the samples in the window, e.g. 0.99 for the
+ *  p99: the smallest sample that at least that fraction of samples do not exceed.
+ *  Zero if there are no samples.
+ *
+ *  Parameters:
+ *    fraction: The percentile as a fraction between 0 and 1.
+ */
+sf::Time FrameStats::percentile(float fraction) const {
+    if (count == 0) {
+        return sf::Time::Zero;
+    }
+
+    sorted.assign(samples.begin(), samples.begin() + count);
+
+    std::size_t rank = static_cast<std::size_t>(std::ceil(std::max(0.0f, std::min(fraction, 1.0f)) * count));
+    std::size_t index = rank > 0 ? rank - 1 : 0;
+
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sf::microseconds(sorted[index]);
+}
+
+/*
+ *  Returns the largest sample in the window, or zero if there are none.
+ */
+sf::Time FrameStats::maximum() const {
+    if (count == 0) {
+        return sf::Time::Zero;
+    }
+
+    return sf::microseconds(*std::max_element(samples.begin(), samples.begin() + count));
+}
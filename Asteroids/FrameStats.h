@@ -0,0 +1,31 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstddef>
+#include <vector>
+
+/*
+ *  Rolling window of timing samples, such as frame or update times, with percentiles over
+ *  the window. Percentiles rather than averages show stutter: a single 50 ms frame among
+ *  a few hundred 7 ms ones barely moves the mean but lands in the p99.
+ *
+ *  Adding a sample is constant time and never allocates; the window is allocated once.
+ */
+class FrameStats {
+public:
+    explicit FrameStats(std::size_t windowSize = 300);
+
+    void add(sf::Time sample);
+    void clear();
+    std::size_t size() const;
+
+    sf::Time percentile(float fraction) const;
+    sf::Time maximum() const;
+
+private:
+    std::vector<sf::Int64> samples; // Microseconds, as a ring buffer
+    std::size_t next;
+    std::size_t count;
+
+    // Reused for sorting, so a query doesn't allocate either
+    mutable std::vector<sf::Int64> sorted;
+};
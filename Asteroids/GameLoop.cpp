@@ -1,62 +1,36 @@
 #include "GameLoop.h"
 #include <stdexcept>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
-#include <cstdlib> 
-#include <ctime> 
-#include <cmath>
+#include "AllocationCounter.h"
+#include "Profiler.h"
 
-GameLoop::GameLoop()
+/*
+ *  Parameters:
+ *    seed: Seeds the simulation's random generator, see Simulation.
+ */
+GameLoop::GameLoop(unsigned int seed)
     : window(sf::VideoMode(width, height), "Asteroids Exercise", sf::Style::Titlebar | sf::Style::Close),
     isRunning(true),
     isCursorGrabbed(true),
     originalAspectRatio(static_cast<float>(width) / static_cast<float>(height)) {
-    textureManager = new TextureManager();
-
-
-    //Load Textures
-    textureManager->loadTexture("AsteroidFull", "Assets/Asteroid2.png", 10.0f, 10.0f); 
-    textureManager->loadTexture("AsteroidHalf", "Assets/Asteroid2.png", 5.0f, 5.0f);
-    textureManager->loadTexture("AsteroidOneFourth", "Assets/Asteroid2.png", 2.5f, 2.5f);
-    textureManager->loadTexture("Laser", "Assets/Laser.png", 2.5f, 2.5f);
-    textureManager->loadTexture("Ship", "Assets/Ship4.png", 5.0f, 5.0f);
-    textureManager->rotateTexture("Ship", -45.0f);
-    textureManager->loadTexture("ShipWithBurner", "Assets/Ship2.png", 5.0f, 5.0f);
-    textureManager->rotateTexture("ShipWithBurner", -45.0f);
-    textureManager->loadTexture("Projectile", "Assets/MissileBig.png", 1.5f, 1.5f);
-    textureManager->loadTexture("EnemyShip", "Assets/EnemyShip.png", 5.0f, 5.0f);
-
-
-    asteroidFullT = &textureManager->getTexture("AsteroidFull");
-    asteroidHalfT = &textureManager->getTexture("AsteroidHalf");
-    asteroidOneFourthT = &textureManager->getTexture("AsteroidOneFourth");
-    shipT = &textureManager->getTexture("Ship");
-    ShipWithBurnerT = &textureManager->getTexture("ShipWithBurner");
-    projectileT = &textureManager->getTexture("Projectile");
-    enemyShipT = &textureManager->getTexture("EnemyShip");
-
-    player.setTexture(*ShipWithBurnerT, *shipT);
-
 
     //Set up vars
-    gracePeriodDuration = sf::seconds(3.0);
-    gracePeriodTimer = sf::Time::Zero;
-    inGracePeriod = false;
-    projectiles = new std::vector<Projectile>;
-    mobs = new std::vector<Mob*>;
     worldSize = sf::Vector2f(static_cast<float>(width), static_cast<float>(height));
-    center = sf::Vector2f(view.getCenter());
-    srand(static_cast<unsigned int>(time(nullptr)));
 
 
     //Set up View and Mouse handling 
     view.setSize(worldSize.x / zoomFactor, worldSize.y / zoomFactor);
     window.setView(view);
-    viewBounds = new sf::FloatRect(view.getCenter() - (view.getSize() / 2.f), view.getSize());
-    sf::Vector2f viewTopLeft = view.getCenter() - (view.getSize() / 2.f);
+    sf::FloatRect viewBounds(view.getCenter() - (view.getSize() / 2.f), view.getSize());
     window.setMouseCursorGrabbed(isCursorGrabbed);
     window.setMouseCursorVisible(!isCursorGrabbed);
-    player.setBounds(*viewBounds);
+
+    simulation = new Simulation(viewBounds, seed);
+    batch = new SpriteBatch(simulation->getTextureManager());
   
 
 
@@ -65,227 +39,234 @@ GameLoop::GameLoop()
         throw std::runtime_error("Failed to load font");
     }
 
-    setUp();
-
-    //Set up text overlay
-    scoreText.setFont(font);
-    scoreText.setCharacterSize(64);
-    scoreText.setFillColor(sf::Color::White);
-    scoreText.setPosition(viewTopLeft.x + 40, viewTopLeft.y + 20);
-    scoreText.setLetterSpacing(1.6);
-
-    livesText.setFont(font);
-    livesText.setCharacterSize(64);
-    livesText.setFillColor(sf::Color::White);
-    livesText.setPosition(viewTopLeft.x + 40, viewTopLeft.y + 100);
-    livesText.setLetterSpacing(1.6);
-
-    pauseText.setFont(font);
-    pauseText.setCharacterSize(64);
-    pauseText.setFillColor(sf::Color::White);
-    pauseText.setLetterSpacing(1.6);
-    pauseText.setString("PAUSED");
-    sf::FloatRect pauseTextBounds = pauseText.getLocalBounds();
-    pauseText.setOrigin(pauseTextBounds.width / 2.0f, pauseTextBounds.height / 2.0f);
-    pauseText.setPosition(center);
-
-    gameOverText.setFont(font);
-    gameOverText.setCharacterSize(64);
-    gameOverText.setFillColor(sf::Color::White);
-    gameOverText.setLetterSpacing(1.6);
-    gameOverText.setString("GAME OVER");
-    sf::FloatRect gameOverTextBounds = gameOverText.getLocalBounds();
-    gameOverText.setOrigin(gameOverTextBounds.width / 2.0f, gameOverTextBounds.height / 2.0f);
-    gameOverText.setPosition(center);
-
+    hud = new Hud(font);
 
+    // Drawn in window pixels rather than world units, see renderStats
+    statsText.setFont(font);
+    statsText.setCharacterSize(14);
+    statsText.setFillColor(sf::Color::White);
+    statsText.setOutlineColor(sf::Color::Black);
+    statsText.setOutlineThickness(1.0f);
 
+    onWorldResized(viewBounds);
+    simulation->getWorld().addListener(*this);
+    hud->setScore(simulation->getScore());
+    hud->setLives(simulation->getLives());
 }
 
 GameLoop::~GameLoop() {
 
-    
-    delete viewBounds;
-    delete projectiles;
-    delete textureManager;
-    //The texture pointers are deleted with textureManager
+    simulation->getWorld().removeListener(*this);
+    delete recorder;
+    delete hud;
+    delete batch;
+    delete simulation;
+}
 
-    for (Mob* mob : *mobs) {
-        delete mob;
-    }
+/*
+ *  Starts writing the input of every update to a file, so the session can be replayed
+ *  later with RecordedInput, e.g. by a headless run.
+ *
+ *  Parameters:
+ *    path: The file to record into.
+ */
+void GameLoop::record(const std::string& path) {
+    delete recorder;
+    recorder = nullptr;
+    recorder = new InputRecorder(path);
+}
 
-    delete mobs;
+/*
+ *  Sets where F9 writes the profiler's trace of the last few seconds (see Profiler).
+ *
+ *  Parameters:
+ *    path: The Chrome trace JSON file to write, replaced on every dump.
+ */
+void GameLoop::trace(const std::string& path) {
+    tracePath = path;
 }
+/*
+ *  Keeps the overlay in place when the world, which matches the view, is resized, see
+ *  Hud::setBounds.
+ */
+void GameLoop::onWorldResized(const sf::FloatRect& bounds) {
+    hud->setBounds(bounds, window.getSize());
+}
+
 /*
 *  Main game loop that handles the core update and rendering cycle.
 *  It maintains a fixed update rate for game logic(UPS - Updates Per Second)
 *  and an uncapped frame rate for rendering.
 *
+*  Every frame, update, render and present is timed into a rolling window for the
+*  statistics overlay (F3, see updateStatsText).
+*
 *  The game loop uses a time accumulator to ensure consistent updates
-*  for more stable gameplay logic.
+*  for more stable gameplay logic. Every update advances the simulation by
+*  exactly 1 / updatesPerSecond, however late it runs, so a session is
+*  reproducible from its seed and recorded input.
 */
 void GameLoop::run() {
     sf::Time lastTime = clock.getElapsedTime();
     sf::Time timer = clock.getElapsedTime();
     double delta = 0.0;
-    const double ns = 1.0 / 60.0; // 60 updates per second
+    const double ns = 1.0 / updatesPerSecond;
+    const sf::Time deltaTime = sf::seconds(static_cast<float>(ns));
     int frames = 0;
     int updates = 0;
 
     while (isRunning && window.isOpen()) {
+        PROFILE_SCOPE("Frame");
         sf::Time now = clock.getElapsedTime();
         delta += (now - lastTime).asSeconds() / ns;
+        frameTimes.add(now - lastTime);
         lastTime = now;
 
         while (delta >= 1) {
 
-            static sf::Time lastUpdate = now;
-            sf::Time deltaTime = now - lastUpdate;
-            lastUpdate = now;
-
-            processEvents(deltaTime);
+            {
+                AllocationCounter::Scope scope(AllocationCounter::Phase::Events);
+                PROFILE_SCOPE("Events");
+                processEvents();
+            }
+            sf::Time updateStart = clock.getElapsedTime();
             update(deltaTime);
+            updateTimes.add(clock.getElapsedTime() - updateStart);
             updates++;
             delta--;
         }
 
-        render(); //Uncapped FPS
+        {
+            AllocationCounter::Scope scope(AllocationCounter::Phase::Render);
+            sf::Time renderStart = clock.getElapsedTime();
+            {
+                PROFILE_SCOPE("Render");
+                render(); //Uncapped FPS
+            }
+
+            sf::Time presentStart = clock.getElapsedTime();
+            renderTimes.add(presentStart - renderStart);
+            {
+                PROFILE_SCOPE("Present");
+                window.display();
+            }
+            presentTimes.add(clock.getElapsedTime() - presentStart);
+        }
         frames++;
 
+        if (showStats && now - statsRefreshed >= statsRefreshInterval) {
+            AllocationCounter::Scope scope(AllocationCounter::Phase::Hud);
+            statsRefreshed = now;
+            updateStatsText();
+        }
+
         if (clock.getElapsedTime().asSeconds() - timer.asSeconds() > 1.0) {
+            AllocationCounter::Scope scope(AllocationCounter::Phase::Hud);
             timer += sf::seconds(1.0);
-            std::string title = "Asteroids Exercise | " + std::to_string(updates) + " UPS, " + std::to_string(frames) + " FPS";
-            window.setTitle(title);
+            reportAllocations();
+            updatesLastSecond = updates;
+            framesLastSecond = frames;
+            collisionStatsLastSecond = simulation->getCollisionStats();
             updates = 0;
             frames = 0;
+            simulation->resetCollisionStats();
         }
     }
 }
 
 /*
- *  Checks for pixel-perfect collision between two Mobs using their textures.
- *  This function first performs a bounding box collision check. If the bounding
- *  boxes intersect, it then checks each pixel within the intersecting area for
- *  transparency. A collision is detected if two opaque pixels (above a certain
- *  alpha threshold) overlap.
- *
- *  Parameters:
- *    sprite1: The first Mob involved in the collision check.
- *    sprite2: The second Mob involved in the collision check.
- *
- *  Returns:
- *    bool: True if a pixel-perfect collision is detected, false otherwise.
- *
- *  Note:
- *    This function can be performance-intensive, especially with larger sprites/textures
- *    or complex scenes, due to its per-pixel checks.
+ *  Rebuilds the statistics overlay: the p50, p95, p99 and worst of the recent frame,
+ *  update, render and present times, last second's update and frame rates and collision
+ *  counts, and how many entities of each type there are.
  */
-bool GameLoop::pixelPerfectCollision(const Mob sprite1, const Mob sprite2) {
-   
-    const unsigned int ALPHA_THRESHOLD = 50;
+void GameLoop::updateStatsText() {
+    std::ostringstream stats;
+    stats << std::fixed << std::setprecision(2);
 
-    if (!sprite1.hasCollision() || !sprite2.hasCollision()) {
-        return false; 
-    }
+    const FrameStats* timings[] = { &frameTimes, &updateTimes, &renderTimes, &presentTimes };
+    const char* names[] = { "Frame  ", "Update ", "Render ", "Present" };
 
-    if (!sprite1.getTexture() || !sprite2.getTexture()) {
-        return false; 
-    }
+    stats << "ms       p50    p95    p99    max\n";
 
-    sf::FloatRect intersection;
-    if (!sprite1.getBounds().intersects(sprite2.getBounds(), intersection)) {
-        return false; 
+    for (int i = 0; i < 4; ++i) {
+        stats << names[i]
+            << std::setw(7) << timings[i]->percentile(0.50f).asSeconds() * 1000.0f
+            << std::setw(7) << timings[i]->percentile(0.95f).asSeconds() * 1000.0f
+            << std::setw(7) << timings[i]->percentile(0.99f).asSeconds() * 1000.0f
+            << std::setw(7) << timings[i]->maximum().asSeconds() * 1000.0f << "\n";
     }
 
-    sf::IntRect rect1 = sprite1.getTextureRect();
-    sf::IntRect rect2 = sprite2.getTextureRect();
-
-    const sf::Image image1 = sprite1.getTexture()->copyToImage();
-    const sf::Image image2 = sprite2.getTexture()->copyToImage();
-
-    sf::Transform transform1 = sprite1.getInverseTransform();
-    sf::Transform transform2 = sprite2.getInverseTransform();
-
-    for (int i = intersection.left; i < intersection.left + intersection.width; i++) {
-        for (int j = intersection.top; j < intersection.top + intersection.height; j++) {
-            sf::Vector2f point1 = transform1.transformPoint(i, j);
-            sf::Vector2i texturePoint1(point1.x - rect1.left, point1.y - rect1.top);
+    stats << updatesLastSecond << " UPS, " << framesLastSecond << " FPS, " << drawCalls << " sprite draw calls ("
+        << (batch->isUsingVertexBuffers() ? "vertex buffer" : "vertex array") << ")\n";
+    stats << "Asteroids " << simulation->getAsteroids().size()
+        << ", enemy ships " << simulation->getEnemyShips().size()
+        << ", projectiles " << simulation->getProjectiles().size() << "\n";
+    stats << "Pairs " << collisionStatsLastSecond.pairs
+        << ", circle -" << collisionStatsLastSecond.circleRejected
+        << ", box -" << collisionStatsLastSecond.boxRejected
+        << ", mask -" << collisionStatsLastSecond.maskRejected
+        << ", hull -" << collisionStatsLastSecond.hullRejected
+        << ", hits " << collisionStatsLastSecond.hits;
+
+    statsText.setString(stats.str());
+}
 
-            sf::Vector2f point2 = transform2.transformPoint(i, j);
-            sf::Vector2i texturePoint2(point2.x - rect2.left, point2.y - rect2.top);
+/*
+ *  Draws the statistics overlay in the top right corner of the window. It uses a view
+ *  in window pixels, so it stays the same size whatever the world view is zoomed to.
+ */
+void GameLoop::renderStats() {
+    sf::Vector2f windowSize(static_cast<float>(window.getSize().x), static_cast<float>(window.getSize().y));
+    window.setView(sf::View(sf::FloatRect(0.0f, 0.0f, windowSize.x, windowSize.y)));
 
-            if (rect1.contains(texturePoint1) && rect2.contains(texturePoint2)) {
-                sf::Color color1 = image1.getPixel(texturePoint1.x, texturePoint1.y);
-                sf::Color color2 = image2.getPixel(texturePoint2.x, texturePoint2.y);
+    sf::FloatRect bounds = statsText.getLocalBounds();
+    statsText.setPosition(std::floor(windowSize.x - bounds.width - bounds.left - 10.0f), 10.0f);
+    window.draw(statsText);
 
-            
-                if (color1.a > ALPHA_THRESHOLD && color2.a > ALPHA_THRESHOLD) {
-                    return true; // Collision detected
-                }
-            }
-        }
-    }
-
-    return false; // No collision detected
+    window.setView(view);
 }
 
 /*
- *  Checks for a bounding box collision between two Mobs. This method is a
- *  simpler and less computationally intensive approach compared to pixel-perfect
- *  collision detection. It's based on comparing the axis-aligned bounding boxes
- *  (AABB) of each sprite to see if they intersect.
- *
- *  Parameters:
- *    sprite1: Reference to the first Mob involved in the collision check.
- *    sprite2: Reference to the second Mob involved in the collision check.
- *
- *  Returns:
- *    bool: True if the bounding boxes of the two Mobs intersect, indicating a collision.
- *          False if the Mobs do not intersect or if either Mob is set to not have collisions.
+ *  In a TRACK_ALLOCATIONS build, prints the heap allocations each phase of the loop made
+ *  over the last second, then starts counting afresh. Does nothing otherwise.
  */
-bool GameLoop::boundingBoxCollision(const Mob& sprite1, const Mob& sprite2) {
-
-    if (!sprite1.hasCollision() || !sprite2.hasCollision()) {
-        return false;
+void GameLoop::reportAllocations() const {
+    if (!AllocationCounter::tracksPhases()) {
+        return;
     }
 
-    sf::FloatRect bounds1 = sprite1.getBounds();
-    sf::FloatRect bounds2 = sprite2.getBounds();
+    std::cout << "Allocations/s:";
 
-    return bounds1.intersects(bounds2);
-}
+    for (int i = 0; i < static_cast<int>(AllocationCounter::Phase::Count); ++i) {
+        AllocationCounter::Phase phase = static_cast<AllocationCounter::Phase>(i);
+        AllocationCounter::PhaseStats stats = AllocationCounter::phaseStats(phase);
+
+        std::cout << " " << AllocationCounter::phaseName(phase) << " " << stats.allocations
+            << " (" << stats.bytes << " B, " << stats.frees << " frees)";
+    }
 
+    std::cout << std::endl;
+    AllocationCounter::resetPhases();
+}
 
 /*
  *  Processes all events polled from the SFML window within the game loop. This function
- *  handles various types of events including window close, window resize, and user inputs
- *  like keyboard and mouse events. Based on the event type, appropriate actions are taken
- *  such as closing the game window, resizing the game view, or updating the player's state
- *  with actions like firing, moving, and rotating.
- *
- *  Parameters:
- *    deltaTime: Represents the time elapsed since the last update cycle in the game loop.
- *               It's used to ensure consistent gameplay mechanics, such as regulating the
- *               fire rate of the player's ship, independent of the frame rate.
+ *  handles window close, window resize, and the mouse and keyboard events that pause and
+ *  resume the game. The player's controls are read separately each update (see readInput).
  *
  *  Key Features:
  *    - Window Close: Triggers the game window to close upon receiving a close event.
- *    - Window Resize: Adjusts the view to maintain the original aspect ratio following a window resize event.
+ *    - Window Resize: Adjusts the view to maintain the original aspect ratio following a window resize event,
+ *                     and makes the new view bounds the simulation's world bounds.
  *    - Escape Key: Utilised to toggle the state of cursor grabbing and to pause the game.
+ *    - F3 Key: Shows or hides the frame time statistics overlay.
+ *    - F9 Key: Writes the profiler's recent spans to the trace file (see trace).
  *    - Mouse Button Press: Engages cursor grabbing and resumes gameplay if previously paused.
- *    - Space Key: Enables the player to fire projectiles, subject to the fire rate constraint dictated by deltaTime.
- *    - W/A/D Keys: Facilitate player movement and rotation.
  *
  *  Note:
- *    Player interactions are contingent upon the game being active (not paused or over) and the cursor being captured.
- *    This mechanism serves as the fundamental pause functionality and state management within the game.
+ *    The cursor being captured serves as the fundamental pause functionality within the game.
  */
-void GameLoop::processEvents(sf::Time deltaTime) {
-
-    static double* fireRateInSeconds = player.fireRateInSeconds;
-
-    static sf::Time timeSinceLastFire = sf::seconds(*fireRateInSeconds);
-    const sf::Time fireRate = sf::seconds(*fireRateInSeconds);
+void GameLoop::processEvents() {
 
     sf::Event event;
     while (window.pollEvent(event)) {
@@ -332,10 +313,22 @@ void GameLoop::processEvents(sf::Time deltaTime) {
       
             window.setView(view);
 
-            *viewBounds = sf::FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize());
+            simulation->getWorld().setBounds(sf::FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize()));
 
         }
  
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+            showStats = !showStats;
+            if (showStats) {
+                updateStatsText();
+            }
+        }
+
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F9) {
+            Profiler::writeTrace(tracePath);
+            std::cout << "Wrote " << Profiler::size() << " profiler spans to " << tracePath << std::endl;
+        }
+
         if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
             isCursorGrabbed = false;
             paused = true;
@@ -350,237 +343,58 @@ void GameLoop::processEvents(sf::Time deltaTime) {
             window.setMouseCursorVisible(!isCursorGrabbed);
         }
 
-
-        if (isCursorGrabbed) {
-            if(gameOver == false && paused == false) {
-                
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
-                    if (timeSinceLastFire >= fireRate) {
-                        player.fire(*projectiles, *projectileT, *mobs);
-                        timeSinceLastFire = sf::Time::Zero;
-                    }
-                }
-
-                sf::Vector2f acceleration(0.0f, 0.0f);
-                bool isMoving = false;
-                bool isTurning = false;
-
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
-                    acceleration.y -= 300.0f; // Move up
-                    isMoving = true;
-                }
-
-
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
-                    player.setRotation(false); //Rotate left
-                    isTurning = true;
-                }
-
-
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
-                    player.setRotation(true); //Rotate right
-                    isTurning = true;
-                }
-
-                player.setAcceleration(acceleration);
-                player.setMoving(isMoving);
-                player.setTurning(isTurning);
-            
-             } else if (gameOver) {
-
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
-
-                    setUp();
-                }
-             }
-        }
-
     } 
-
-    timeSinceLastFire += deltaTime;
 }
-
 /*
- *  Updates the game state based on the time elapsed since the last frame (deltaTime).
- *  This includes processing player inputs, updating mob positions, checking for collisions,
- *  and managing game events like spawning asteroids and enemy ships. The function also
- *  handles the game's pause state and the grace period following a collision.
- *
- *  Parameters:
- *    deltaTime: Time elapsed since the last update, used for time-dependent calculations
- *               like movement, spawning intervals, and the grace period duration.
+ *  Reads the player's controls from the keyboard. Nothing is held while the game is
+ *  paused or the cursor is not captured.
  *
- *  Key Actions:
- *    - Score Update: Updates the score display based on the current score.
- *    - Pause Check: Returns immediately if the game is paused or over, halting updates.
- *    - Grace Period Handling: Manages the invulnerability period after the player collides with a mob.
- *    - Player Update: Processes player movements and actions based on user inputs.
- *    - Mob Spawning: Periodically spawns asteroids and enemy ships based on timers.
- *    - Mob Updates: Updates all mobs, including enemy ships with special logic for targeting the player.
- *    - Collision Detection: Checks for collisions between the player, mobs, and projectiles,
- *                           applying game logic like splitting asteroids and removing lives.
- *    - Projectile Management: Updates projectile positions, removes off-screen projectiles,
- *                             and handles collisions with mobs or the player.
- *
- *  Note:
- *    The function ensures that all game logic is processed in a consistent manner, adhering
- *    to the fixed time step defined by deltaTime. This approach provides a stable and uniform
- *    gameplay experience across different hardware.
+ *  Key Features:
+ *    - Space Key: Fires projectiles, subject to the player's fire rate, or starts a new game after game over.
+ *    - W/A/D Keys: Facilitate player movement and rotation.
  */
-void GameLoop::update(sf::Time deltaTime) {
-
-
-    scoreText.setString("Score: " + std::to_string(score));
-
-    if (isCursorGrabbed) {
-        sf::Vector2i pixelPos = sf::Mouse::getPosition(window);
-        sf::Vector2f worldPos = window.mapPixelToCoords(pixelPos, view);
-    }
-
-    //Stop Updates
-    if (gameOver || paused) {
-        return;
-    }
-
-    if (inGracePeriod) {
-        gracePeriodTimer += deltaTime;
-        if (gracePeriodTimer >= gracePeriodDuration) {
-            inGracePeriod = false;
-            gracePeriodTimer = sf::Time::Zero;
-        }
-    }
-
-    player.update(deltaTime);
+PlayerInput GameLoop::readInput() const {
+    PlayerInput input;
 
-    asteroidSpawnTimer += deltaTime;
-    enemyShipSpawnTimer += deltaTime;
-
-    if (asteroidSpawnTimer.asSeconds() >= 7) {
-        spawnMob(Mob::Type::Asteroid);
-        asteroidSpawnTimer = sf::Time::Zero;
-    }
-
-    if (enemyShipSpawnTimer.asSeconds() >= 25) {
-        spawnMob(Mob::Type::EnemyShip);
-        enemyShipSpawnTimer = sf::Time::Zero;
-    }
-
-    sf::Vector2f playerPos = player.getPosition();
-
-    for (auto& mob : *mobs) {
-
-        if (mob->type() == Mob::Type::EnemyShip) {
-            EnemyShip* enemyShip = dynamic_cast<EnemyShip*>(mob);
-            if (enemyShip) {
-                enemyShip->update(deltaTime, playerPos);
-            }
-        } else {
-            mob->update(deltaTime);
-        }
-
-        if (!mob->hasBounds() && isFullyOnScreen(*mob)) {
-            mob->setBounds(*viewBounds);
-        }
-    }
-
-    std::vector<Asteroid> newAsteroids;
-
-    for (auto mobIt = mobs->begin(); mobIt != mobs->end();) {
-      
-        if (!inGracePeriod) {
-
-            bool collided = pixelPerfectCollision(player, **mobIt);
-
-            if (collided) {
-
-                removeLife();
-
-
-                if ((*mobIt)->type() == Mob::Type::Asteroid) {
-                    Asteroid* asteroid = dynamic_cast<Asteroid*>(*mobIt); 
-                    if (asteroid) {
-                        asteroid->split(newAsteroids);
-                    }
-                }
-
-                delete* mobIt; 
-
-                mobIt = mobs->erase(mobIt);
-
-            }
-            else {
-                ++mobIt;
-            }
-        }  else {
-            ++mobIt;
-        }
+    if (!isCursorGrabbed || paused) {
+        return input;
     }
 
+    input.fire = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+    input.thrust = sf::Keyboard::isKeyPressed(sf::Keyboard::W);
+    input.turnLeft = sf::Keyboard::isKeyPressed(sf::Keyboard::A);
+    input.turnRight = sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+    return input;
+}
 
-    for (auto projectileIt = projectiles->begin(); projectileIt != projectiles->end();) {
-        projectileIt->update(deltaTime);
+/*
+ *  Advances the simulation by one update with the player's current controls, recording
+ *  them if a recording was requested, and refreshes the score and lives text.
+ *  Nothing advances while the game is paused.
+ *
+ *  Parameters:
+ *    deltaTime: Time elapsed since the last update.
+ */
+void GameLoop::update(sf::Time deltaTime) {
+    PROFILE_SCOPE("Update");
 
-        auto projectilePos = projectileIt->getPosition();
-        bool offScreen = projectilePos.x < viewBounds->left || projectilePos.x > viewBounds->left + viewBounds->width ||
-            projectilePos.y < viewBounds->top || projectilePos.y > viewBounds->top + viewBounds->height;
+    if (!paused) {
+        AllocationCounter::Scope scope(AllocationCounter::Phase::Update);
+        PlayerInput input = readInput();
 
-        if (offScreen) {
-            projectileIt = projectiles->erase(projectileIt);
+        if (recorder != nullptr) {
+            recorder->record(input);
         }
-        else {
-            bool collided = false;
-            if (projectileIt->targetPlayer) {
-                if (!inGracePeriod) {
-        
-                    if (pixelPerfectCollision(*projectileIt, player)) {
-         
-                        removeLife();
-
-      
-                        projectileIt = projectiles->erase(projectileIt);
-                        collided = true;
 
-               
-                    }
-                }
-            }
-            else {
-         
-                for (auto mobIt = mobs->begin(); mobIt != mobs->end() && !collided;) {
-                    if (pixelPerfectCollision(*projectileIt, **mobIt)) {
-                        score += 100; 
-                        projectileIt = projectiles->erase(projectileIt);
-
-              
-                        if ((*mobIt)->type() == Mob::Type::Asteroid) {
-                            Asteroid* asteroid = dynamic_cast<Asteroid*>(*mobIt);
-                            if (asteroid) {
-                                asteroid->split(newAsteroids);  
-                            }
-                        }
-
-                        // Remove the Mob object
-                        delete* mobIt;  
-                        mobIt = mobs->erase(mobIt);
-
-                        collided = true;
-                    }
-                    else {
-                        ++mobIt;
-                    }
-                }
-            }
-
-            if (!collided) {
-                ++projectileIt;
-            }
-        }
+        simulation->update(deltaTime, input);
     }
 
-    for (const auto& asteroid : newAsteroids) {
-        Asteroid* newAsteroidPtr = new Asteroid(asteroid);
-        mobs->push_back(newAsteroidPtr);
-    }
+    // Only changed values touch the overlay, see Hud
+    AllocationCounter::Scope scope(AllocationCounter::Phase::Hud);
+    hud->setScore(simulation->getScore());
+    hud->setLives(simulation->getLives());
+    hud->setPaused(paused);
+    hud->setGameOver(simulation->isGameOver());
 }
 
 /*
@@ -590,11 +404,14 @@ void GameLoop::update(sf::Time deltaTime) {
  *
  *  - Clears the window and sets the view for rendering.
  *  - Renders the player, with flashing during the grace period.
- *  - Iterates and renders all projectiles and mobs.
- *  - Displays score, lives (or game over message), and pause message as applicable.
- *  - Finalises rendering by displaying all drawn elements.
+ *  - Renders all projectiles and mobs, batched into one draw per atlas page (see renderGroup).
+ *  - Draws the overlay of score, lives (or game over message), and pause message as one
+ *    cached quad, see Hud.
+ *  - Draws the statistics overlay when it is shown.
+ *  - Leaves presenting the frame to run, which times it separately.
  */
 void GameLoop::render() {
+    drawCalls = 0;
     window.clear(sf::Color::Black);
     window.setView(view);
 
@@ -603,268 +420,97 @@ void GameLoop::render() {
     float flashInterval = 1.0f / 3.0f;
 
     
-    if (paused || !inGracePeriod || ((int)(gracePeriodTimer.asSeconds() / flashInterval)) % 2 == 0) {
-        player.render(window);
+    if (paused || !simulation->isInGracePeriod() || ((int)(simulation->getGracePeriodTimer().asSeconds() / flashInterval)) % 2 == 0) {
+        PROFILE_SCOPE("Render player");
+        renderGroup(simulation->getPlayers());
        //player.debugAimingCone(window, 200.0f);
     }
 
-    for (auto& projectile : *projectiles) {
-       projectile.render(window);
+    {
+        PROFILE_SCOPE("Render projectiles");
+        renderGroup(simulation->getProjectiles());
     }
 
-    for (auto& mob : *mobs) {
-        mob->render(window);
+    {
+        PROFILE_SCOPE("Render mobs");
+        renderGroup(simulation->getAsteroids());
+        renderGroup(simulation->getEnemyShips());
     }
 
-    window.draw(scoreText);
-
-    if(!gameOver) {
-        window.draw(livesText);
-
-        if (paused) {
-            window.draw(pauseText);
-        }
-    }
-    else {
-        window.draw(gameOverText);
+    // Every store shares the atlas, so this is normally a single draw call
+    {
+        PROFILE_SCOPE("Render batch");
+        drawCalls += batch->draw(window);
     }
 
- 
-
- 
-    window.display();
-}
-
-/*
- *  Efficiently renders a group of Mobs using a vertex array. This method assumes all Mobs in the group
- *  share the same texture. It constructs a quad for each Mob and sets texture coordinates accordingly,
- *  allowing for batch rendering which can improve performance.
- *
- *  - Checks if the group is not empty to proceed with rendering.
- *  - Retrieves the shared texture from the first Mob in the group.
- *  - Initialises a vertex array as Quads to represent each Mob.
- *  - Iterates over the group, setting vertex positions and texture coordinates for each Mob.
- *  - Draws the entire group in a single draw call using the shared texture.
- *
- *  This method is particularly useful for rendering large numbers of similar objects.
- */
-void GameLoop::renderGroup(std::vector<Mob>& group) {
+    {
+        AllocationCounter::Scope scope(AllocationCounter::Phase::Hud);
+        PROFILE_SCOPE("Render text");
+        hud->draw(window);
 
-    if (!group.empty()) {
-
-        // All in the group share the same texture
-        const sf::Texture* texture = group.at(0).getTexture();
-
-        // Create a vertex array with quads, 4 vertices for each in the group
-        sf::VertexArray vertices(sf::Quads, group.size() * 4);
-
-        for (std::size_t i = 0; i < group.size(); ++i) {
-            const auto& proj = group.at(i);
-
-            const sf::FloatRect bounds = proj.getBounds();
-            const sf::IntRect texRect = proj.getTextureRect();
-
-            // Calculate the 4 corners of the quad for an item in the group
-            vertices[i * 4 + 0].position = sf::Vector2f(bounds.left, bounds.top);
-            vertices[i * 4 + 1].position = sf::Vector2f(bounds.left + bounds.width, bounds.top);
-            vertices[i * 4 + 2].position = sf::Vector2f(bounds.left + bounds.width, bounds.top + bounds.height);
-            vertices[i * 4 + 3].position = sf::Vector2f(bounds.left, bounds.top + bounds.height);
-
-            // Set the texture coordinates for each corner of the quad
-            vertices[i * 4 + 0].texCoords = sf::Vector2f(texRect.left, texRect.top);
-            vertices[i * 4 + 1].texCoords = sf::Vector2f(texRect.left + texRect.width, texRect.top);
-            vertices[i * 4 + 2].texCoords = sf::Vector2f(texRect.left + texRect.width, texRect.top + texRect.height);
-            vertices[i * 4 + 3].texCoords = sf::Vector2f(texRect.left, texRect.top + texRect.height);
+        if (showStats) {
+            renderStats();
         }
-
-
-        window.draw(vertices, texture);
     }
 }
 
 /*
- *  Checks if a given Mob is within the current screen view.
- *
- *  Parameters:
- *    mob: The Mob to check for partial visibility.
+ *  Queues every visible entity in a store in the sprite batch, which render draws once
+ *  every store is queued. Each quad comes from the entity's full transform, so rotation
+ *  is kept. Quads on one atlas page are drawn in the order they were queued, so stores
+ *  queued later still draw on top.
  *
- *  Returns:
- *    bool: True if the Mob's bounding box intersects with the view bounds, indicating it's on screen.
- *          False otherwise.
- */
-bool GameLoop::isOnScreen(const Mob& mob) {
-    return viewBounds->intersects(mob.getBounds());
-}
-
-/*
- *  Determines if a Mob is completely within the current screen view, without any part
- *  of it extending beyond the view boundaries.
+ *  A wrapping entity that straddles a view edge is also drawn shifted across to the
+ *  opposite side, and one in a corner gets the diagonal copy too: up to four quads in
+ *  all. Only the simulation moves entities across (see Simulation::wrapAround), so this
+ *  only reads the store.
  *
  *  Parameters:
- *    mob: The Mob to check for complete visibility.
- *
- *  Returns:
- *    bool: True if the entire Mob is within the view bounds, ensuring no part is off-screen.
- *          False if any part of the Mob extends beyond the view boundaries.
- *
- *  This function is useful for determining whether a Mob should have it's viewBounds set,
- *  making sure it doesn't warp after spawning
- */
-bool GameLoop::isFullyOnScreen(const Mob& mob) {
-    sf::FloatRect mobBounds = mob.getBounds(); 
-
-    sf::Vector2f mobCenter = mob.getPosition();  
-    mobBounds.left = mobCenter.x - mobBounds.width / 2.0f;
-    mobBounds.top = mobCenter.y - mobBounds.height / 2.0f;
-
-    bool isLeftEdgeInside = mobBounds.left >= viewBounds->left;
-    bool isRightEdgeInside = mobBounds.left + mobBounds.width <= viewBounds->left + viewBounds->width;
-    bool isTopEdgeInside = mobBounds.top >= viewBounds->top;
-    bool isBottomEdgeInside = mobBounds.top + mobBounds.height <= viewBounds->top + viewBounds->height;
-
-    return isLeftEdgeInside && isRightEdgeInside && isTopEdgeInside && isBottomEdgeInside;
-}
-
-
-/*
- *  Spawns a new Mob of the specified type at a random location just outside the view boundaries,
- *  with a randomised velocity and direction. The spawn location is determined by randomly selecting
- *  one of the four edges of the screen (top, right, bottom, left).
- *
- *  Parameters:
- *    type: The type of Mob to spawn, defined by the Mob::Type enumeration.
- *
- *  Functionality:
- *    - Randomly selects a spawn side and calculates a corresponding start position just off-screen.
- *    - Sets a base speed and applies a random angle deviation to give the Mob a varied velocity.
- *    - Initialises the Mob based on its type, sets its texture, and adds it to the mobs vector.
+ *    group: The entities to draw.
  */
-void GameLoop::spawnMob(Mob::Type type) {
-
-    int side = rand() % 4; // 0 = top, 1 = right, 2 = bottom, 3 = left
-    sf::Vector2f startPosition;
-    sf::Vector2f velocity;
-
-    float baseSpeed = 500.0f;
-
-    // Angle deviation within 80 degrees (in radians)
-    float angleDeviation = static_cast<float>((rand() % 160 - 80) * PI / 180.0);
-
-    Mob* newMob = nullptr;
-
-    // Initialise the new mob based on its type
-    switch (type) {
-    case Mob::Type::Asteroid:
-        newMob = new Asteroid();
-        newMob->setTexture(*asteroidFullT);
-        break;
-    case Mob::Type::EnemyShip:
-        newMob = new EnemyShip(projectiles, textureManager);
-        newMob->setTexture(*enemyShipT);
-        break;
-    default:
-        std::cerr << "Unsupported Mob Type" << std::endl;
-        return; // Early return if the type is not supported
-    }
-
-    newMob->setTextureManager(*textureManager);
-
-    sf::FloatRect mobBounds = newMob->getBounds();
-
-    // Determine startPosition and velocity based on the chosen side
-    switch (side) {
-    case 0: // Top
-        startPosition.x = viewBounds->left + static_cast<float>(rand() % static_cast<int>(viewBounds->width));
-        startPosition.y = viewBounds->top - mobBounds.height / 2; 
-        velocity = sf::Vector2f(rand() % 200 - 100, baseSpeed); // Random horizontal component, fixed downward component
-        break;
-    case 1: // Right
-        startPosition.x = viewBounds->left + viewBounds->width + mobBounds.width / 2; 
-        startPosition.y = viewBounds->top + static_cast<float>(rand() % static_cast<int>(viewBounds->height));
-        velocity = sf::Vector2f(-baseSpeed, rand() % 200 - 100); // Fixed leftward component, random vertical component
-        break;
-    case 2: // Bottom
-        startPosition.x = viewBounds->left + static_cast<float>(rand() % static_cast<int>(viewBounds->width));
-        startPosition.y = viewBounds->top + viewBounds->height + mobBounds.height / 2; 
-        velocity = sf::Vector2f(rand() % 200 - 100, -baseSpeed); // Random horizontal component, fixed upward component
-        break;
-    case 3: // Left
-        startPosition.x = viewBounds->left - mobBounds.width / 2; 
-        startPosition.y = viewBounds->top + static_cast<float>(rand() % static_cast<int>(viewBounds->height));
-        velocity = sf::Vector2f(baseSpeed, rand() % 200 - 100); // Fixed rightward component, random vertical component
-        break;
-    }
+void GameLoop::renderGroup(const EntityStore& group) {
+    const sf::FloatRect& viewBounds = simulation->getWorld().getBounds();
 
-    float velMagnitude = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
-    float velAngle = std::atan2(velocity.y, velocity.x) + angleDeviation;
-    velocity = sf::Vector2f(std::cos(velAngle) * velMagnitude, std::sin(velAngle) * velMagnitude);
+    for (std::size_t i = 0; i < group.size(); ++i) {
+        sf::Transform transform = group.getTransform(i);
+        sf::FloatRect bounds = transform.transformRect(sf::FloatRect(0.0f, 0.0f, group.extent[i].x, group.extent[i].y));
 
-    newMob->setPosition(startPosition);
-    newMob->setVelocity(velocity);
-    mobs->push_back(newMob);
-}
+        if (bounds.intersects(viewBounds)) {
+            batch->add(group.texture[i], transform, group.extent[i]);
+        }
 
-/*
- *  Resets the specified Mob to its initial state by repositioning it to the centre of the game area,
- *  nullifying its velocity, and setting its rotation to zero. This function is typically invoked
- *  following events such as player loses a life or game restarts to ensure a consistent starting point.
- *
- *  Parameters:
- *    mob: Reference to the Mob object that requires reinitialisation.
- *
- *  Functionality:
- *    - Repositions the Mob to the central point of the play area.
- *    - Sets the Mob's velocity to a standstill (0.0f, 0.0f) to halt any movement.
- *    - Resets the Mob's orientation by setting its rotation angle to zero.
- */
-void GameLoop::reset(Mob& mob) {
-    mob.setPosition(center);
-    mob.setVelocity(sf::Vector2f(0.0f, 0.0f));
-    mob.setRotation(0.0f);
-}
+        if (!group.wraps[i]) {
+            continue;
+        }
 
+        // Shift across each edge the entity straddles, if any
+        float shiftX = 0.0f;
+        float shiftY = 0.0f;
 
-/*
- *  Prepares the game for a new session by resetting stats, clearing entities,
- *  and spawning initial mobs. Used at game start or after a game over.
- */
-void GameLoop::setUp() {
-    gameOver = false;
-    paused = false;
-    score = 0;
-    lives = 3; 
-    livesText.setString("Lives: " + std::to_string(lives));
-    scoreText.setString("Score: 0");
-    projectiles->clear(); 
-    mobs->clear();
-    reset(player);
-
-    asteroidSpawnTimer = sf::Time::Zero;
-    enemyShipSpawnTimer = sf::Time::Zero;
-
-    for (int i = 0; i < 2; i++) {
-        spawnMob(Mob::Type::Asteroid);
-        spawnMob(Mob::Type::EnemyShip);
-    }
+        if (bounds.left < viewBounds.left) {
+            shiftX = viewBounds.width;
+        }
+        else if (bounds.left + bounds.width > viewBounds.left + viewBounds.width) {
+            shiftX = -viewBounds.width;
+        }
 
-   
-}
+        if (bounds.top < viewBounds.top) {
+            shiftY = viewBounds.height;
+        }
+        else if (bounds.top + bounds.height > viewBounds.top + viewBounds.height) {
+            shiftY = -viewBounds.height;
+        }
 
-/*
- *  Decreases player lives and updates display. Sets game over if no lives left,
- *  resets player and initiates grace period to prevent immediate collisions.
- */
-void GameLoop::removeLife() {
-    lives -= 1;
-    livesText.setString("Lives: " + std::to_string(lives));
+        if (shiftX != 0.0f) {
+            batch->add(group.texture[i], transform, group.extent[i], sf::Vector2f(shiftX, 0.0f));
+        }
 
+        if (shiftY != 0.0f) {
+            batch->add(group.texture[i], transform, group.extent[i], sf::Vector2f(0.0f, shiftY));
+        }
 
-    if (lives <= 0) {
-        gameOver = true;
-        return;
+        if (shiftX != 0.0f && shiftY != 0.0f) {
+            batch->add(group.texture[i], transform, group.extent[i], sf::Vector2f(shiftX, shiftY));
+        }
     }
-
-    reset(player);
-    inGracePeriod = true;
-    gracePeriodTimer = sf::Time::Zero;
 }
\ No newline at end of file
@@ -1,80 +1,69 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include "Mob.h"
-#include "Player.h"
-#include "Asteroid.h"
-#include "Projectile.h"
-#include "TextureManager.h"
-#include "EnemyShip.h"
+#include <string>
+#include "EntityStore.h"
+#include "FrameStats.h"
+#include "Hud.h"
+#include "SpriteBatch.h"
+#include "Simulation.h"
+#include "InputSource.h"
+#include "World.h"
 
-class GameLoop {
+class GameLoop : public WorldListener {
 public:
-    GameLoop();
+    explicit GameLoop(unsigned int seed);
     virtual ~GameLoop();
     void run();
-    bool pixelPerfectCollision(const Mob sprite1, const Mob sprite2);
-    bool boundingBoxCollision(const Mob& sprite1, const Mob& sprite2);
-
+    void record(const std::string& path);
+    void trace(const std::string& path);
+    void onWorldResized(const sf::FloatRect& bounds) override;
 
 private:
     int width = 800;
     int height = 800;
     float zoomFactor = 0.5f;
-    const float PI = 3.14159265358979323846f;
+    int updatesPerSecond = 60;
 
     sf::RenderWindow window;
     sf::View view;
     sf::Vector2f worldSize;
     sf::Clock clock;
-    sf::FloatRect* viewBounds;
-    sf::Vector2f center;
 
-    Player player;
-    Asteroid asteroid;
+    Simulation* simulation;
+    InputRecorder* recorder = nullptr;
+    SpriteBatch* batch;
+    std::size_t drawCalls = 0; // Sprite batch draws in the current frame
+    std::string tracePath = "trace.json";
 
     bool isRunning;
     bool isCursorGrabbed;
-    bool gameOver = false;
     bool paused = false;
-    bool inGracePeriod;
 
     const float originalAspectRatio;
     sf::Font font;
-   
-    int score;
-    int lives;
-
-    sf::Text scoreText;
-    sf::Text livesText;
-    sf::Text pauseText;
-    sf::Text gameOverText;
 
-    std::vector<Projectile>* projectiles;
-    std::vector<Mob*>* mobs;
-    TextureManager* textureManager;
+    Hud* hud = nullptr;
 
-    const sf::Texture* asteroidFullT;
-    const sf::Texture* asteroidHalfT;
-    const sf::Texture* asteroidOneFourthT;
-    const sf::Texture* shipT;
-    const sf::Texture* ShipWithBurnerT;
-    const sf::Texture* projectileT;
-    const sf::Texture* enemyShipT;
+    // Statistics overlay, toggled with F3
+    sf::Text statsText;
+    bool showStats = false;
+    sf::Time statsRefreshed;
+    sf::Time statsRefreshInterval = sf::seconds(0.25f);
+    FrameStats frameTimes;
+    FrameStats updateTimes;
+    FrameStats renderTimes;
+    FrameStats presentTimes;
+    int updatesLastSecond = 0;
+    int framesLastSecond = 0;
+    Simulation::CollisionStats collisionStatsLastSecond;
 
-    sf::Time gracePeriodDuration;
-    sf::Time gracePeriodTimer;
-    sf::Time asteroidSpawnTimer;
-    sf::Time enemyShipSpawnTimer;
-
-    void spawnMob(Mob::Type type);
-    void processEvents(sf::Time deltaTime);
+    void processEvents();
+    PlayerInput readInput() const;
     void update(sf::Time deltaTime);
+    void reportAllocations() const;
+    void updateStatsText();
+    void renderStats();
+
     void render();
-    void renderGroup(std::vector<Mob>& group);
-    void spawnAsteroid();
-    bool isOnScreen(const Mob& mob);
-    bool isFullyOnScreen(const Mob& mob);
-    void reset(Mob& mob);
-    void setUp();
-    void removeLife();
+    void renderGroup(const EntityStore& group);
 };
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "HeadlessLoop.h"
+#include <cstddef>
+#include <iostream>
+#include "AllocationCounter.h"
+#include "Profiler.h"
+
+/*
+ *  Sets up a headless simulation over the same world bounds the windowed game starts with.
+ *
+ *  Parameters:
+ *    input: Supplies the player's controls for each update.
+ *    ticks: The maximum number of updates to run. The run also stops early once a
+ *           recording has been played back in full.
+ *    seed:  Seeds the simulation's random generator, see Simulation.
+ */
+HeadlessLoop::HeadlessLoop(InputSource& input, int ticks, unsigned int seed) : ticks(ticks), input(input) {
+    sf::View view;
+    view.setSize(width / zoomFactor, height / zoomFactor);
+    sf::FloatRect worldBounds(view.getCenter() - (view.getSize() / 2.f), view.getSize());
+
+    simulation = new Simulation(worldBounds, seed, true);
+}
+
+HeadlessLoop::~HeadlessLoop() {
+    delete simulation;
+}
+
+/*
+ *  Advances the simulation by a fixed 1/updatesPerSecond step per tick, without waiting
+ *  for real time to pass, then prints how long the run took, how the game ended up and
+ *  how much memory each kind of entity takes. In a COUNT_ALLOCATIONS build, heap
+ *  allocations made inside update are counted per tick; once warmUpTicks have passed, a
+ *  steady-state run should make none.
+ *  A tick in which an entity store grows past its reserve is counted as warm-up too.
+ *  The final state hash is the same for every run with the same seed and input.
+ */
+void HeadlessLoop::run() {
+    const sf::Time deltaTime = sf::seconds(1.0f / updatesPerSecond);
+    sf::Clock clock;
+    int tick = 0;
+
+    std::size_t warmUpAllocations = 0;
+    std::size_t steadyAllocations = 0;
+    int allocatingTicks = 0;
+    int growingTicks = 0;
+
+    auto reserved = [this]() {
+        return simulation->getPlayers().reserved() + simulation->getAsteroids().reserved()
+            + simulation->getEnemyShips().reserved() + simulation->getProjectiles().reserved();
+    };
+
+    for (; tick < ticks && !input.finished(); tick++) {
+        PlayerInput playerInput = input.next();
+
+        std::size_t allocationsBefore = AllocationCounter::count();
+        std::size_t reservedBefore = reserved();
+        {
+            AllocationCounter::Scope scope(AllocationCounter::Phase::Update);
+            PROFILE_SCOPE("Update");
+            simulation->update(deltaTime, playerInput);
+        }
+        std::size_t allocations = AllocationCounter::count() - allocationsBefore;
+
+        if (tick < warmUpTicks) {
+            warmUpAllocations += allocations;
+        }
+        else if (reserved() != reservedBefore) {
+            warmUpAllocations += allocations;
+            growingTicks++;
+        }
+        else if (allocations > 0) {
+            steadyAllocations += allocations;
+            allocatingTicks++;
+        }
+    }
+
+    float elapsed = clock.getElapsedTime().asSeconds();
+    const Simulation::CollisionStats& collisionStats = simulation->getCollisionStats();
+
+    std::cout << "Simulated " << tick << " ticks (" << tick / static_cast<float>(updatesPerSecond) << " s of play) in "
+        << elapsed * 1000.0f << " ms, " << (elapsed > 0.0f ? tick / elapsed : 0.0f) << " ticks/s" << std::endl;
+    std::cout << "Score " << simulation->getScore() << ", lives " << simulation->getLives()
+        << (simulation->isGameOver() ? " (game over)" : "") << ", " << simulation->getAsteroids().size() + simulation->getEnemyShips().size() << " mobs, "
+        << simulation->getProjectiles().size() << " projectiles" << std::endl;
+    std::cout << "Pairs " << collisionStats.pairs << ", circle -" << collisionStats.circleRejected
+        << ", box -" << collisionStats.boxRejected << ", mask -" << collisionStats.maskRejected
+        << ", hull -" << collisionStats.hullRejected << ", hits " << collisionStats.hits << std::endl;
+    std::cout << "Bytes per entity: player " << simulation->getPlayers().bytesPerEntity()
+        << ", asteroid " << simulation->getAsteroids().bytesPerEntity()
+        << ", enemy ship " << simulation->getEnemyShips().bytesPerEntity()
+        << ", projectile " << simulation->getProjectiles().bytesPerEntity() << std::endl;
+
+    if (AllocationCounter::counts()) {
+        std::cout << "Heap allocations in update: " << warmUpAllocations << " over the first " << warmUpTicks << " ticks and "
+            << growingTicks << " ticks that grew a store, " << steadyAllocations << " after (" << allocatingTicks
+            << " ticks allocated); ";
+    }
+    else {
+        std::cout << "Heap allocations not counted (build with COUNT_ALLOCATIONS); ";
+    }
+    std::cout << "frame arena peak " << simulation->getFrameArena().peak() << " bytes" << std::endl;
+
+    if (AllocationCounter::tracksPhases()) {
+        for (AllocationCounter::Phase phase : { AllocationCounter::Phase::Update, AllocationCounter::Phase::Collision }) {
+            AllocationCounter::PhaseStats stats = AllocationCounter::phaseStats(phase);
+            std::cout << "  " << AllocationCounter::phaseName(phase) << ": " << stats.allocations << " allocations, "
+                << stats.bytes << " bytes, " << stats.frees << " frees" << std::endl;
+        }
+    }
+    std::cout << "Seed " << simulation->getSeed() << ", state hash " << std::hex << simulation->stateHash() << std::dec << std::endl;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <SFML/System.hpp>
+#include "Simulation.h"
+#include "InputSource.h"
+
+/*
+ *  Runs the simulation without a window or graphics context, as fast as it will go,
+ *  with input from a script or recording. Used for benchmarks, soak tests and replays.
+ */
+class HeadlessLoop {
+public:
+    HeadlessLoop(InputSource& input, int ticks, unsigned int seed);
+    virtual ~HeadlessLoop();
+    void run();
+
+private:
+    int width = 800;
+    int height = 800;
+    float zoomFactor = 0.5f;
+    int updatesPerSecond = 60;
+    int warmUpTicks = 60; // Allowed to allocate while stores and the frame arena grow
+    int ticks;
+
+    InputSource& input;
+    Simulation* simulation;
+};
@@ -0,0 +1,150 @@
+#include "Hud.h"
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Text is drawn into the transparent cache with its colour premultiplied by its
+    // alpha, and the cache is then composited as premultiplied. Plain alpha blending
+    // would apply the glyphs' antialiasing alpha twice and thin their edges.
+    const sf::BlendMode cacheBlend(sf::BlendMode::SrcAlpha, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add,
+        sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add);
+    const sf::BlendMode compositeBlend(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+}
+
+/*
+ *  Parameters:
+ *    font: The font of every text. Must outlive the overlay.
+ */
+Hud::Hud(const sf::Font& font) {
+    setUp(scoreLabel, font);
+    setUp(scoreValue, font);
+    setUp(livesLabel, font);
+    setUp(livesValue, font);
+    setUp(pauseText, font);
+    setUp(gameOverText, font);
+
+    scoreLabel.setString("Score: ");
+    livesLabel.setString("Lives: ");
+
+    pauseText.setString("PAUSED");
+    sf::FloatRect pauseTextBounds = pauseText.getLocalBounds();
+    pauseText.setOrigin(pauseTextBounds.width / 2.0f, pauseTextBounds.height / 2.0f);
+
+    gameOverText.setString("GAME OVER");
+    sf::FloatRect gameOverTextBounds = gameOverText.getLocalBounds();
+    gameOverText.setOrigin(gameOverTextBounds.width / 2.0f, gameOverTextBounds.height / 2.0f);
+}
+
+void Hud::setUp(sf::Text& text, const sf::Font& font) const {
+    text.setFont(font);
+    text.setCharacterSize(64);
+    text.setFillColor(sf::Color::White);
+    text.setLetterSpacing(1.6f);
+}
+
+/*
+ *  Lays the overlay out over the world, which matches the view: score and lives in the
+ *  top left corner, pause and game over messages in the centre. The cache is recreated
+ *  if the resolution changed, and redrawn on the next draw either way.
+ *
+ *  Parameters:
+ *    bounds: The world bounds, in world units.
+ *    resolution: The size in pixels the world is shown at, normally the window's size.
+ */
+void Hud::setBounds(const sf::FloatRect& bounds, const sf::Vector2u& resolution) {
+    sf::Vector2f topLeft(bounds.left, bounds.top);
+    sf::Vector2f center(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+
+    scoreLabel.setPosition(topLeft.x + 40, topLeft.y + 20);
+    livesLabel.setPosition(topLeft.x + 40, topLeft.y + 100);
+    scoreValue.setPosition(scoreLabel.findCharacterPos(scoreLabel.getString().getSize()));
+    livesValue.setPosition(livesLabel.findCharacterPos(livesLabel.getString().getSize()));
+    pauseText.setPosition(center);
+    gameOverText.setPosition(center);
+
+    if (cache.getSize() != resolution) {
+        if (!cache.create(resolution.x, resolution.y)) {
+            throw std::runtime_error("Failed to create HUD texture");
+        }
+
+        quad.setTexture(cache.getTexture(), true);
+    }
+
+    cacheView.reset(bounds);
+    quad.setPosition(topLeft);
+    quad.setScale(bounds.width / resolution.x, bounds.height / resolution.y);
+    dirty = true;
+}
+
+void Hud::setScore(int score) {
+    if (score == this->score) {
+        return;
+    }
+
+    this->score = score;
+    scoreValue.setString(std::to_string(score));
+    dirty = true;
+}
+
+void Hud::setLives(int lives) {
+    if (lives == this->lives) {
+        return;
+    }
+
+    this->lives = lives;
+    livesValue.setString(std::to_string(lives));
+    dirty = true;
+}
+
+void Hud::setPaused(bool paused) {
+    if (paused != this->paused) {
+        this->paused = paused;
+        dirty = true;
+    }
+}
+
+void Hud::setGameOver(bool gameOver) {
+    if (gameOver != this->gameOver) {
+        this->gameOver = gameOver;
+        dirty = true;
+    }
+}
+
+/*
+ *  Draws the overlay as one quad over the world bounds, redrawing the cache first if
+ *  anything on it changed. The target's view should be the world view.
+ */
+void Hud::draw(sf::RenderTarget& target) {
+    if (dirty) {
+        redraw();
+    }
+
+    target.draw(quad, compositeBlend);
+}
+
+/*
+ *  Renders the texts that are currently shown into the cache: the score always, then
+ *  lives and the pause message while playing, or the game over message once it ends.
+ */
+void Hud::redraw() {
+    cache.setView(cacheView);
+    cache.clear(sf::Color::Transparent);
+
+    cache.draw(scoreLabel, cacheBlend);
+    cache.draw(scoreValue, cacheBlend);
+
+    if (!gameOver) {
+        cache.draw(livesLabel, cacheBlend);
+        cache.draw(livesValue, cacheBlend);
+
+        if (paused) {
+            cache.draw(pauseText, cacheBlend);
+        }
+    }
+    else {
+        cache.draw(gameOverText, cacheBlend);
+    }
+
+    cache.display();
+    dirty = false;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <climits>
+
+/*
+ *  The score, lives, pause and game over overlay, drawn over the world as one textured
+ *  quad. The text is rendered into an offscreen sf::RenderTexture at the window's
+ *  resolution, and that cache is only redrawn when something shown on it changes: a new
+ *  score or lives count, pausing, the game ending or the world being resized. Setting a
+ *  value that is already shown does nothing, so feeding the overlay every update costs
+ *  no allocations and no glyph rebuilds.
+ *
+ *  The "Score:" and "Lives:" labels are separate texts from the numbers after them, so
+ *  only the number's geometry is rebuilt when it changes.
+ */
+class Hud {
+public:
+    explicit Hud(const sf::Font& font);
+
+    void setBounds(const sf::FloatRect& bounds, const sf::Vector2u& resolution);
+    void setScore(int score);
+    void setLives(int lives);
+    void setPaused(bool paused);
+    void setGameOver(bool gameOver);
+
+    void draw(sf::RenderTarget& target);
+
+private:
+    sf::Text scoreLabel;
+    sf::Text scoreValue;
+    sf::Text livesLabel;
+    sf::Text livesValue;
+    sf::Text pauseText;
+    sf::Text gameOverText;
+
+    // What the cache shows. The values start out of range, so the first set always takes
+    int score = INT_MIN;
+    int lives = INT_MIN;
+    bool paused = false;
+    bool gameOver = false;
+
+    sf::RenderTexture cache;
+    sf::View cacheView;
+    sf::Sprite quad;
+    bool dirty = true;
+
+    void setUp(sf::Text& text, const sf::Font& font) const;
+    void redraw();
+};
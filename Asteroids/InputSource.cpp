@@ -0,0 +1,84 @@
+#include "InputSource.h"
+#include <stdexcept>
+
+ScriptedInput::ScriptedInput() : tick(0) {
+
+}
+
+/*
+ *  Thrusts for half of every three seconds, sweeps right then left across a two second
+ *  cycle and holds fire throughout, leaving the player's fire rate to space the shots.
+ */
+PlayerInput ScriptedInput::next() {
+    PlayerInput input;
+    input.thrust = tick % 180 < 90;
+    input.turnRight = tick % 120 < 30;
+    input.turnLeft = tick % 120 >= 60 && tick % 120 < 90;
+    input.fire = true;
+
+    tick++;
+    return input;
+}
+
+/*
+ *  Loads a recording made by InputRecorder.
+ *  Throws a runtime_error if the file cannot be opened.
+ *
+ *  Parameters:
+ *    path: The file to read.
+ */
+RecordedInput::RecordedInput(const std::string& path) : position(0) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to open input recording " + path);
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        PlayerInput input;
+        input.thrust = line.find('W') != std::string::npos;
+        input.turnLeft = line.find('A') != std::string::npos;
+        input.turnRight = line.find('D') != std::string::npos;
+        input.fire = line.find('F') != std::string::npos;
+        inputs.push_back(input);
+    }
+}
+
+PlayerInput RecordedInput::next() {
+    if (position >= inputs.size()) {
+        return PlayerInput();
+    }
+
+    return inputs[position++];
+}
+
+bool RecordedInput::finished() const {
+    return position >= inputs.size();
+}
+
+/*
+ *  Opens a file to record into, replacing any existing recording.
+ *  Throws a runtime_error if the file cannot be created.
+ *
+ *  Parameters:
+ *    path: The file to write.
+ */
+InputRecorder::InputRecorder(const std::string& path) : file(path) {
+    if (!file) {
+        throw std::runtime_error("Failed to create input recording " + path);
+    }
+}
+
+/*
+ *  Appends one update's input as a line of key letters: W to thrust, A and D to turn
+ *  and F to fire, or "-" when nothing is held.
+ */
+void InputRecorder::record(const PlayerInput& input) {
+    std::string line;
+    if (input.thrust) line += 'W';
+    if (input.turnLeft) line += 'A';
+    if (input.turnRight) line += 'D';
+    if (input.fire) line += 'F';
+
+    file << (line.empty() ? "-" : line) << '\n';
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+ *  The player's controls for a single update. The window fills this in from the
+ *  keyboard; headless runs take it from a script or a recording instead.
+ */
+struct PlayerInput {
+    bool thrust = false;
+    bool turnLeft = false;
+    bool turnRight = false;
+    bool fire = false;
+};
+
+/*
+ *  Supplies one PlayerInput per simulation update.
+ */
+class InputSource {
+public:
+    virtual ~InputSource() {}
+    virtual PlayerInput next() = 0;
+    virtual bool finished() const { return false; }
+};
+
+/*
+ *  Fixed, repeating pattern of inputs that keeps the player moving, turning and firing.
+ *  Useful for soak tests and benchmarks where no recording is available.
+ */
+class ScriptedInput : public InputSource {
+public:
+    ScriptedInput();
+    PlayerInput next() override;
+
+private:
+    unsigned long tick;
+};
+
+/*
+ *  Plays back inputs saved by an InputRecorder, one line per update. Once the
+ *  recording runs out every further update gets no input and finished() is true.
+ */
+class RecordedInput : public InputSource {
+public:
+    explicit RecordedInput(const std::string& path);
+    PlayerInput next() override;
+    bool finished() const override;
+
+private:
+    std::vector<PlayerInput> inputs;
+    std::size_t position;
+};
+
+/*
+ *  Writes the input of every update to a file in the format RecordedInput reads.
+ */
+class InputRecorder {
+public:
+    explicit InputRecorder(const std::string& path);
+    void record(const PlayerInput& input);
+
+private:
+    std::ofstream file;
+};
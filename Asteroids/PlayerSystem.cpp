@@ -0,0 +1,221 @@
+#include "PlayerSystem.h"
+#include <cmath>
+#include <limits>
+
+PlayerSystem::PlayerSystem(TextureManager& textureManager, ProjectileSystem& projectileSystem)
+    : textureManager(&textureManager), projectileSystem(&projectileSystem) {
+
+    primaryTexture = textureManager.getHandle("ShipWithBurner");
+    secondaryTexture = textureManager.getHandle("Ship");
+    projectileTexture = textureManager.getHandle("Projectile");
+}
+
+/*
+ *  Adds the player's ship to an empty store, motionless at the origin, for the caller to place.
+ *
+ *  Returns:
+ *    The ship's index, always 0.
+ */
+std::size_t PlayerSystem::spawn(EntityStore& players) {
+    sf::Vector2u size = textureManager->getTextureSize(primaryTexture);
+
+    return players.add(primaryTexture, sf::Vector2f(static_cast<float>(size.x), static_cast<float>(size.y)),
+        sf::Vector2f(0.0f, 0.0f), sf::Vector2f(0.0f, 0.0f), 0.0f);
+}
+
+/*
+ *  Updates the player's position, velocity, and animation based on user input and game mechanics.
+ *
+ *  Parameters:
+ *    players:   The store holding the player's ship.
+ *    deltaTime: Time elapsed since the last update cycle.
+ */
+void PlayerSystem::update(EntityStore& players, sf::Time deltaTime) {
+    sf::Vector2f& velocity = players.velocity[0];
+
+    if (!moving) {
+        velocity *= decelerationFactor;  // Apply deceleration when not moving
+    }
+    else {
+        float rotationInRadians = (players.rotation[0] - 90) * (3.14159265f / 180.0f);
+        sf::Vector2f forward(std::cos(rotationInRadians), std::sin(rotationInRadians));
+
+        sf::Vector2f forwardAcceleration = forward * std::sqrt(acceleration.x * acceleration.x + acceleration.y * acceleration.y);
+        forwardAcceleration *= accelerationFactor;
+
+        velocity += forwardAcceleration * deltaTime.asSeconds();
+    }
+
+    // Apply a drag
+    if (turning) {
+        velocity *= 1.0f - (dragFactor * deltaTime.asSeconds());
+    }
+
+    // Clamp the velocity to the maxSpeed in any direction
+    float currentSpeed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    if (currentSpeed > maxSpeed.x) {
+        velocity = (velocity / currentSpeed) * maxSpeed.x;
+    }
+
+    players.position[0] += velocity * deltaTime.asSeconds();
+
+
+    textureToggleTimer += deltaTime;
+
+    //Player Animation
+    if (moving || turning) {
+        float currentDuration = isPrimaryTextureActive ? primaryTextureDuration : secondaryTextureDuration;
+
+        if (textureToggleTimer.asSeconds() >= currentDuration) {
+            isPrimaryTextureActive = !isPrimaryTextureActive;
+            textureToggleTimer = sf::Time::Zero;
+
+
+            if (isPrimaryTextureActive) {
+                setTexture(players, primaryTexture);
+
+            } else {
+                setTexture(players, secondaryTexture);
+            }
+        }
+    }
+    else {
+        if (!isPrimaryTextureActive) {
+            setTexture(players, secondaryTexture);
+        }
+        isPrimaryTextureActive = false;
+    }
+}
+
+/*
+ *  Fires a projectile from the player's position towards the nearest target within the aiming cone.
+ *
+ *  Parameters:
+ *    players:            The store holding the player's ship.
+ *    projectileCommands: The projectile store's command buffer, which the shot is requested from.
+ *    asteroids:          The asteroids that can be targeted.
+ *    enemyShips:         The enemy ships that can be targeted.
+ */
+void PlayerSystem::fire(EntityStore& players, CommandBuffer& projectileCommands, const EntityStore& asteroids,
+    const EntityStore& enemyShips) {
+    sf::Vector2f position = players.position[0];
+    float rotation = players.rotation[0];
+    sf::Vector2f direction = sf::Vector2f(std::cos((rotation - 90) * (3.14159265f / 180.0f)),
+        std::sin((rotation - 90) * (3.14159265f / 180.0f)));
+
+    bool wraps = players.wraps[0] != 0;
+
+    EntityStore::Handle selectedMob;
+    EntityStore::Type selectedType = EntityStore::Type::Asteroid;
+    float closestDistanceSquared = std::numeric_limits<float>::max();
+
+    const EntityStore* targetStores[2] = { &asteroids, &enemyShips };
+
+    for (const EntityStore* mobs : targetStores) {
+        for (std::size_t i = 0; i < mobs->size(); ++i) {
+            if (projectileSystem->withinAimingCone(position, rotation, wraps, mobs->position[i])) {
+                sf::Vector2f mobDir = mobs->position[i] - position;
+                float mobDistanceSquared = mobDir.x * mobDir.x + mobDir.y * mobDir.y;
+
+
+                if (mobDistanceSquared < closestDistanceSquared) {
+                    closestDistanceSquared = mobDistanceSquared;
+                    selectedMob = mobs->handle[i];
+                    selectedType = mobs->getType();
+                }
+            }
+        }
+    }
+
+    std::size_t projectile = projectileSystem->fire(projectileCommands, projectileTexture, position, direction, rotation, projectileSpeed);
+
+    if (projectile == EntityStore::npos) {
+        return;
+    }
+
+    EntityStore& projectiles = projectileCommands.spawns();
+
+    if (wraps) {
+        projectiles.setWraps(projectile);
+    }
+
+    projectiles.target[projectile] = selectedMob;
+    projectiles.targetType[projectile] = selectedType;
+}
+
+/*
+ *  Draws debug lines representing the aiming cone of the player's ship.
+ *
+ *  Parameters:
+ *    players: The store holding the player's ship.
+ *    target:  Render target to draw the debug lines.
+ *    length:  Length of the aiming cone lines.
+ */
+void PlayerSystem::debugAimingCone(const EntityStore& players, sf::RenderTarget& target, float length) const {
+    float halfAngleRadians = (60.0f / 2.0f) * (3.14159265f / 180.0f);
+    float rotationInRadians = (players.rotation[0] - 90) * (3.14159265f / 180.0f);
+    sf::Vector2f position = players.position[0];
+
+
+    sf::Vector2f directionLeft = sf::Vector2f(std::cos(rotationInRadians - halfAngleRadians), std::sin(rotationInRadians - halfAngleRadians));
+    sf::Vector2f directionRight = sf::Vector2f(std::cos(rotationInRadians + halfAngleRadians), std::sin(rotationInRadians + halfAngleRadians));
+
+
+    sf::Vector2f endLeft = position + directionLeft * length;
+    sf::Vector2f endRight = position + directionRight * length;
+
+
+    sf::Vertex lineLeft[] = { sf::Vertex(position), sf::Vertex(endLeft) };
+    sf::Vertex lineRight[] = { sf::Vertex(position), sf::Vertex(endRight) };
+
+
+    lineLeft[0].color = sf::Color::Red;
+    lineLeft[1].color = sf::Color::Red;
+    lineRight[0].color = sf::Color::Red;
+    lineRight[1].color = sf::Color::Red;
+
+    // Draw the lines to the render target
+    target.draw(lineLeft, 2, sf::Lines);
+    target.draw(lineRight, 2, sf::Lines);
+}
+
+void PlayerSystem::setAcceleration(const sf::Vector2f& newAcceleration) {
+    acceleration = newAcceleration;
+
+}
+
+/*
+ *  Turns the player for one update while a turn key is held.
+ *
+ *  Parameters:
+ *    players:   The store holding the player's ship.
+ *    right:     True to turn clockwise, false to turn anticlockwise.
+ *    deltaTime: Time elapsed since the last update cycle.
+ */
+void PlayerSystem::setRotation(EntityStore& players, bool right, sf::Time deltaTime) {
+
+    float rotationStep = rotationFactor * deltaTime.asSeconds() * (right ? 1.0f : -1.0f);
+
+    // Kept in [0, 360) as sf::Transformable::setRotation does
+    float newRotation = std::fmod(players.rotation[0] + rotationStep, 360.0f);
+    if (newRotation < 0) {
+        newRotation += 360.0f;
+    }
+    players.rotation[0] = newRotation;
+}
+
+void PlayerSystem::setMoving(bool isMoving) {
+    moving = isMoving;
+}
+
+void PlayerSystem::setTurning(bool isTurning) {
+    turning = isTurning;
+}
+
+/*
+ *  Switches the player's ship to another texture, resizing it to match.
+ */
+void PlayerSystem::setTexture(EntityStore& players, TextureManager::Handle texture) {
+    sf::Vector2u size = textureManager->getTextureSize(texture);
+    players.setTexture(0, texture, sf::Vector2f(static_cast<float>(size.x), static_cast<float>(size.y)));
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "CommandBuffer.h"
+#include "EntityStore.h"
+#include "ProjectileSystem.h"
+#include "TextureManager.h"
+
+/*
+ *  Player behaviour over the player's ship, which is entity 0 of its EntityStore:
+ *  thrust, turning and drag, the burner animation, and firing projectiles that home
+ *  in on the nearest mob in the aiming cone. The control state set each update lives
+ *  here rather than in the store, as there is only ever one player.
+ */
+class PlayerSystem {
+public:
+    PlayerSystem(TextureManager& textureManager, ProjectileSystem& projectileSystem);
+
+    std::size_t spawn(EntityStore& players);
+    void update(EntityStore& players, sf::Time deltaTime);
+
+    void setAcceleration(const sf::Vector2f& newAcceleration);
+    void setRotation(EntityStore& players, bool right, sf::Time deltaTime);
+    void setMoving(bool isMoving);
+    void setTurning(bool isTurning);
+    void fire(EntityStore& players, CommandBuffer& projectileCommands, const EntityStore& asteroids, const EntityStore& enemyShips);
+    void debugAimingCone(const EntityStore& players, sf::RenderTarget& target, float length) const;
+
+    double fireRateInSeconds = 0.5;
+    float rotationFactor = 240.0f; // Degrees per second
+    float primaryTextureDuration = 0.6f;
+    float secondaryTextureDuration = 0.3f;
+
+private:
+    void setTexture(EntityStore& players, TextureManager::Handle texture);
+
+    TextureManager* textureManager;
+    ProjectileSystem* projectileSystem;
+    TextureManager::Handle primaryTexture;
+    TextureManager::Handle secondaryTexture;
+    TextureManager::Handle projectileTexture;
+
+    float projectileSpeed = 1000.0f;
+    sf::Vector2f acceleration = sf::Vector2f(0.0f, 0.0f);
+    sf::Vector2f maxSpeed = sf::Vector2f(10000.0f, 10000.0f);
+    float decelerationFactor = 0.95f;
+    float accelerationFactor = 2.6f;
+    sf::Time textureToggleTimer;
+    bool isPrimaryTextureActive = true;
+    float dragFactor = 1.7f;
+    bool moving = false;
+    bool turning = false;
+};
@@ -0,0 +1,117 @@
+#include "Profiler.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+#ifdef ENABLE_PROFILER
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    Profiler::Span spans[Profiler::capacity];
+    std::size_t next = 0;  // Where the next span goes
+    std::size_t count = 0; // Spans held, at most capacity
+
+    /*
+     *  Writes a span name as a JSON string. Names are identifiers, so only quotes and
+     *  backslashes need escaping.
+     */
+    void writeName(std::ofstream& file, const char* name) {
+        file << '"';
+        for (const char* c = name; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\') {
+                file << '\\';
+            }
+            file << *c;
+        }
+        file << '"';
+    }
+#endif
+}
+
+/*
+ *  Returns true if this is an ENABLE_PROFILER build, which records spans.
+ */
+bool Profiler::enabled() {
+#ifdef ENABLE_PROFILER
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ *  Returns the nanoseconds since the profiler started, or 0 when it is disabled.
+ */
+std::int64_t Profiler::now() {
+#ifdef ENABLE_PROFILER
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+#else
+    return 0;
+#endif
+}
+
+/*
+ *  Adds a span to the ring buffer, overwriting the oldest once it is full. Spans are
+ *  stored as they end, so a parent comes after its children.
+ *
+ *  Parameters:
+ *    name:  What was timed. Only the pointer is kept.
+ *    start: When it started, from now().
+ *    end:   When it ended, from now().
+ */
+void Profiler::record(const char* name, std::int64_t start, std::int64_t end) {
+#ifdef ENABLE_PROFILER
+    spans[next] = { name, start, end - start };
+    next = (next + 1) % capacity;
+    if (count < capacity) {
+        count++;
+    }
+#else
+    (void)name;
+    (void)start;
+    (void)end;
+#endif
+}
+
+std::size_t Profiler::size() {
+#ifdef ENABLE_PROFILER
+    return count;
+#else
+    return 0;
+#endif
+}
+
+void Profiler::clear() {
+#ifdef ENABLE_PROFILER
+    next = 0;
+    count = 0;
+#endif
+}
+
+/*
+ *  Writes every span in the buffer, oldest first, as complete ("X") events in Chrome's
+ *  trace event format, with times in microseconds. The buffer is left as it is.
+ *  Throws a runtime_error if the file cannot be created.
+ */
+void Profiler::writeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to create trace " + path);
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+#ifdef ENABLE_PROFILER
+    std::size_t first = (next + capacity - count) % capacity;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const Span& span = spans[(first + i) % capacity];
+
+        file << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        writeName(file, span.name);
+        file << ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << span.start / 1000 << '.' << span.start % 1000 / 100
+            << ",\"dur\":" << span.duration / 1000 << '.' << span.duration % 1000 / 100 << '}';
+    }
+#endif
+
+    file << "\n]}\n";
+}
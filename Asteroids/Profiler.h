@@ -0,0 +1,55 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+ *  Scoped timers for the game loop's hot path. PROFILE_SCOPE("name") times the rest of the
+ *  enclosing block and records it as a span in a fixed-size ring buffer, which keeps the
+ *  last few seconds of frames. writeTrace dumps the buffer as Chrome trace event JSON,
+ *  which chrome://tracing and ui.perfetto.dev open directly.
+ *
+ *  Timing is only compiled in when ENABLE_PROFILER is defined. Otherwise PROFILE_SCOPE
+ *  expands to nothing, no buffer is allocated and writeTrace writes an empty trace.
+ *  Spans are recorded from the main thread only; nothing here is synchronised.
+ */
+class Profiler {
+public:
+    // Span names must outlive the profiler, normally string literals
+    struct Span {
+        const char* name;
+        std::int64_t start; // Nanoseconds since the profiler started
+        std::int64_t duration;
+    };
+
+    class Scope {
+    public:
+        explicit Scope(const char* name) : name(name), start(now()) {}
+        ~Scope() { record(name, start, now()); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name;
+        std::int64_t start;
+    };
+
+    static const std::size_t capacity = 1 << 16;
+
+    static bool enabled();
+    static std::int64_t now();
+    static void record(const char* name, std::int64_t start, std::int64_t end);
+    static std::size_t size();
+    static void clear();
+    static void writeTrace(const std::string& path);
+};
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
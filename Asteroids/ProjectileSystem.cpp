@@ -0,0 +1,125 @@
+#include "ProjectileSystem.h"
+#include <cmath>
+
+ProjectileSystem::ProjectileSystem(TextureManager& textureManager, const World& world)
+    : textureManager(&textureManager), world(&world) {
+
+}
+
+/*
+ *  Requests a projectile travelling in a straight line until given a target. It joins
+ *  the projectile store when the commands are next flushed.
+ *
+ *  Parameters:
+ *    projectileCommands: The projectile store's command buffer.
+ *    texture:     The projectile's texture.
+ *    position:    Where the projectile starts.
+ *    direction:   The unit direction it travels in.
+ *    rotation:    The rotation it is drawn with, and which its aiming cone faces.
+ *    speed:       Its speed in units per second.
+ *
+ *  Returns:
+ *    The new projectile's index in projectileCommands.spawns(), or EntityStore::npos if
+ *    the store is full and the shot is dropped.
+ */
+std::size_t ProjectileSystem::fire(CommandBuffer& projectileCommands, TextureManager::Handle texture, const sf::Vector2f& position,
+    const sf::Vector2f& direction, float rotation, float speed) {
+
+    if (projectileCommands.full()) {
+        return EntityStore::npos;
+    }
+
+    sf::Vector2u size = textureManager->getTextureSize(texture);
+
+    return projectileCommands.spawns().add(texture, sf::Vector2f(static_cast<float>(size.x), static_cast<float>(size.y)),
+        position, direction * speed, rotation);
+}
+
+/*
+ *  Moves every projectile along its velocity, steering any with a target towards it.
+ *  A projectile stops tracking once its target leaves the aiming cone or no longer
+ *  exists. The position before the move is kept so collision can sweep the path
+ *  covered this tick.
+ *
+ *  Parameters:
+ *    projectiles: The projectiles to update.
+ *    asteroids:   The asteroids projectiles can target.
+ *    enemyShips:  The enemy ships projectiles can target.
+ *    deltaTime:   Time elapsed since the last update cycle.
+ */
+void ProjectileSystem::update(EntityStore& projectiles, const EntityStore& asteroids, const EntityStore& enemyShips, sf::Time deltaTime) {
+    for (std::size_t i = 0; i < projectiles.size(); ++i) {
+        projectiles.previousPosition[i] = projectiles.position[i];
+
+        sf::Vector2f velocity = projectiles.velocity[i];
+        float speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+
+        if (!projectiles.target[i].isNull() && speed > 0.0f) {
+            const EntityStore& targets = projectiles.targetType[i] == EntityStore::Type::Asteroid ? asteroids : enemyShips;
+            std::size_t targetIndex = targets.find(projectiles.target[i]);
+
+            if (targetIndex == EntityStore::npos ||
+                !withinAimingCone(projectiles.position[i], projectiles.rotation[i], projectiles.wraps[i] != 0, targets.position[targetIndex])) {
+                // Target destroyed or moved out of the aiming cone, stop tracking
+                projectiles.target[i] = EntityStore::Handle();
+            }
+            else {
+                // Target is still within the aiming cone, continue tracking
+                sf::Vector2f direction = velocity / speed;
+                sf::Vector2f targetDirection = targets.position[targetIndex] - projectiles.position[i];
+
+                float targetMagnitude = std::sqrt(targetDirection.x * targetDirection.x + targetDirection.y * targetDirection.y);
+                sf::Vector2f normalizedTargetDirection = targetDirection / targetMagnitude;
+
+                direction = direction + (normalizedTargetDirection - direction) * interpolationFactor;
+
+                float directionMagnitude = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+                projectiles.velocity[i] = direction / directionMagnitude * speed;
+            }
+        }
+
+        projectiles.position[i] += projectiles.velocity[i] * deltaTime.asSeconds();
+    }
+}
+
+/*
+ *  Checks if a target is within the aiming cone of a projectile.
+ *
+ *  Parameters:
+ *    position:       The projectile's position.
+ *    rotation:       The projectile's rotation; the cone faces its nose.
+ *    wraps:          Whether the projectile wraps around the world. Targets outside the
+ *                    world, and every target when this is false, are never within the cone.
+ *    targetPosition: The position of the target to check.
+ *
+ *  Returns:
+ *    True if the target is within the aiming cone, false otherwise.
+ */
+bool ProjectileSystem::withinAimingCone(const sf::Vector2f& position, float rotation, bool wraps,
+    const sf::Vector2f& targetPosition) const {
+
+    if (!wraps) return false;
+
+    float rotationInRadians = (rotation - 90) * (3.14159265f / 180.0f);
+    sf::Vector2f direction = sf::Vector2f(std::cos(rotationInRadians), std::sin(rotationInRadians));
+
+    if (!world->getBounds().contains(targetPosition)) {
+        return false;
+    }
+
+    sf::Vector2f mobDir = targetPosition - position;
+    float mobDistanceSquared = mobDir.x * mobDir.x + mobDir.y * mobDir.y;
+
+
+    sf::Vector2f normDirection = direction / std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    sf::Vector2f normMobDir = mobDir / std::sqrt(mobDistanceSquared);
+
+
+    float dot = normDirection.x * normMobDir.x + normDirection.y * normMobDir.y;
+    float angle = std::acos(dot);
+
+    float coneWidth = aimAssistAngle * (3.14159265f / 180.0f);
+
+
+    return angle <= coneWidth / 2.0f;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "CommandBuffer.h"
+#include "EntityStore.h"
+#include "TextureManager.h"
+#include "World.h"
+
+/*
+ *  Projectile behaviour over an EntityStore of projectiles: flying straight, or
+ *  homing in on a target that stays inside the aiming cone.
+ */
+class ProjectileSystem {
+public:
+    ProjectileSystem(TextureManager& textureManager, const World& world);
+
+    std::size_t fire(CommandBuffer& projectileCommands, TextureManager::Handle texture, const sf::Vector2f& position,
+        const sf::Vector2f& direction, float rotation, float speed);
+    void update(EntityStore& projectiles, const EntityStore& asteroids, const EntityStore& enemyShips, sf::Time deltaTime);
+    bool withinAimingCone(const sf::Vector2f& position, float rotation, bool wraps,
+        const sf::Vector2f& targetPosition) const;
+
+    float aimAssistAngle = 60.0f;
+    float interpolationFactor = 1.05f;
+
+private:
+    TextureManager* textureManager;
+    const World* world;
+};
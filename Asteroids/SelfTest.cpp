@@ -0,0 +1,234 @@
+#include "SelfTest.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+/*
+ *  Runs every check, printing one line per check.
+ *
+ *  Parameters:
+ *    headless: Skips the checks that need an OpenGL context.
+ *
+ *  Returns:
+ *    bool: True if every check passed.
+ */
+bool SelfTest::run(bool headless) {
+    bool passed = testWrapCollisions();
+    passed = testHulls() && passed;
+
+    if (headless) {
+        std::cout << "Sprite batch: skipped in a headless run" << std::endl;
+    }
+    else {
+        passed = testSpriteBatch() && passed;
+    }
+
+    std::cout << (passed ? "All self tests passed" : "Self tests FAILED") << std::endl;
+    return passed;
+}
+
+/*
+ *  Draws frames of 300, 1500 and 100 quads through a streaming batch and a batch drawing
+ *  from memory, comparing the pixels of each frame. If the driver has no vertex buffers
+ *  both batches draw from memory, which is reported but not a failure.
+ */
+bool SelfTest::testWrapCollisions() {
+    bool offScreenHit = spawnEdgeCollides(false);
+    bool wrappedHit = spawnEdgeCollides(true);
+    bool passed = !offScreenHit && wrappedHit;
+
+    std::cout << "Wrap collisions at the spawn edge: " << (passed ? "ok" : "FAILED") << " (off screen "
+        << (offScreenHit ? "hit" : "missed") << ", wrapping " << (wrappedHit ? "hit" : "missed") << ")" << std::endl;
+    return passed;
+}
+
+/*
+ *  Runs one update of a headless simulation with the player resting just inside the
+ *  bottom edge and a still asteroid just outside the top edge, in line with it, so the
+ *  asteroid's wrapped image overlaps the player.
+ *
+ *  Parameters:
+ *    asteroidWraps: Whether the asteroid wraps yet. A wrapping asteroid that far out is
+ *                   moved across to the bottom edge by the update and should be hit.
+ *
+ *  Returns:
+ *    bool: True if the player lost a life.
+ */
+bool SelfTest::spawnEdgeCollides(bool asteroidWraps) {
+    sf::FloatRect bounds(0.0f, 0.0f, 1600.0f, 1600.0f);
+    Simulation simulation(bounds, 1, true);
+
+    simulation.getAsteroids().clear();
+    simulation.getEnemyShips().clear();
+    simulation.getProjectiles().clear();
+
+    EntityStore& players = simulation.getPlayers();
+    float centreX = bounds.left + bounds.width / 2.0f;
+    players.position[0] = sf::Vector2f(centreX, bounds.top + bounds.height / 2.0f);
+    players.velocity[0] = sf::Vector2f(0.0f, 0.0f);
+    players.rotation[0] = 0.0f;
+    sf::FloatRect playerBounds = players.getBounds(0);
+    players.position[0].y = bounds.top + bounds.height - playerBounds.height / 2.0f - 2.0f;
+
+    const TextureManager& textureManager = simulation.getTextureManager();
+    TextureManager::Handle texture = textureManager.getHandle("AsteroidFull");
+    sf::Vector2u size = textureManager.getTextureSize(texture);
+    sf::Vector2f extent(static_cast<float>(size.x), static_cast<float>(size.y));
+    sf::Vector2f position(centreX, bounds.top - extent.y / 2.0f - 2.0f);
+
+    EntityStore& asteroids = simulation.getAsteroids();
+    std::size_t asteroid = asteroids.add(texture, extent, position, sf::Vector2f(0.0f, 0.0f), 0.0f);
+    asteroids.asteroidSize[asteroid] = 2;
+
+    if (asteroidWraps) {
+        asteroids.setWraps(asteroid);
+    }
+
+    int lives = simulation.getLives();
+    simulation.update(sf::seconds(1.0f / 60.0f), PlayerInput());
+    return simulation.getLives() < lives;
+}
+
+/*
+ *  Tests 20000 random pairs of the textures the simulation loads, rotated and offset so
+ *  that most of them are close, with both the hulls and the masks. Prints how often the
+ *  two agree.
+ */
+bool SelfTest::testHulls() {
+    Simulation simulation(sf::FloatRect(0.0f, 0.0f, 1600.0f, 1600.0f), 1, true);
+    const TextureManager& textureManager = simulation.getTextureManager();
+
+    const char* names[] = { "AsteroidFull", "AsteroidHalf", "AsteroidOneFourth", "Laser", "Projectile", "EnemyShip", "Ship", "ShipWithBurner" };
+    const std::size_t nameCount = sizeof(names) / sizeof(names[0]);
+    const int pairs = 20000;
+
+    random.seed(1);
+    std::uniform_int_distribution<std::size_t> name(0, nameCount - 1);
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+    std::uniform_real_distribution<float> offset(-60.0f, 60.0f);
+
+    int maskHits = 0;
+    int agreed = 0;
+    int missed = 0;
+
+    for (int i = 0; i < pairs; ++i) {
+        TextureManager::Handle first = textureManager.getHandle(names[name(random)]);
+        TextureManager::Handle second = textureManager.getHandle(names[name(random)]);
+        sf::Vector2f firstSize(textureManager.getTextureSize(first));
+        sf::Vector2f secondSize(textureManager.getTextureSize(second));
+
+        sf::Transform firstTransform;
+        firstTransform.translate(500.0f, 500.0f).rotate(angle(random)).translate(-firstSize / 2.0f);
+        sf::Transform secondTransform;
+        secondTransform.translate(500.0f + offset(random), 500.0f + offset(random)).rotate(angle(random))
+            .translate(-secondSize / 2.0f);
+
+        bool maskHit = CollisionMask::overlap(textureManager.getCollisionMask(first), firstTransform,
+            textureManager.getCollisionMask(second), secondTransform);
+        bool hullHit = CollisionHull::overlap(textureManager.getCollisionHull(first), firstTransform,
+            textureManager.getCollisionHull(second), secondTransform);
+
+        maskHits += maskHit ? 1 : 0;
+        agreed += maskHit == hullHit ? 1 : 0;
+        missed += maskHit && !hullHit ? 1 : 0;
+    }
+
+    bool passed = missed == 0;
+
+    std::cout << "Hulls against masks: " << (passed ? "ok" : "FAILED") << " (" << pairs << " pairs, " << maskHits
+        << " mask hits, " << 100.0f * agreed / pairs << "% agree, " << missed << " mask hits missed)" << std::endl;
+    return passed;
+}
+
+bool SelfTest::testSpriteBatch() {
+    TextureManager textureManager(true);
+    textureManager.loadTexture("Asteroid", "Assets/Asteroid2.png", 2.5f, 2.5f);
+    textureManager.loadTexture("Ship", "Assets/Ship4.png", 2.5f, 2.5f);
+    textureManager.rotateTexture("Ship", -45.0f);
+    textureManager.loadTexture("Projectile", "Assets/MissileBig.png", 1.5f, 1.5f);
+    textureManager.loadTexture("EnemyShip", "Assets/EnemyShip.png", 2.5f, 2.5f);
+    textureManager.buildAtlas();
+
+    sf::RenderTexture target;
+    if (!target.create(width, height)) {
+        throw std::runtime_error("Failed to create self test render texture");
+    }
+
+    SpriteBatch streamed(textureManager);
+    SpriteBatch fromMemory(textureManager);
+    fromMemory.setUseVertexBuffers(false);
+
+    if (!streamed.isUsingVertexBuffers()) {
+        std::cout << "Sprite batch: vertex buffers are not available, only the in-memory path is drawn" << std::endl;
+    }
+
+    const std::size_t frames[] = { 300, 1500, 100 };
+    bool passed = true;
+
+    for (std::size_t frame = 0; frame < sizeof(frames) / sizeof(frames[0]); ++frame) {
+        unsigned int seed = static_cast<unsigned int>(frame + 1);
+
+        queueFrame(streamed, textureManager, frames[frame], seed);
+        sf::Image streamedImage = drawFrame(streamed, target);
+
+        queueFrame(fromMemory, textureManager, frames[frame], seed);
+        sf::Image fromMemoryImage = drawFrame(fromMemory, target);
+
+        std::size_t differing = 0;
+        std::size_t drawn = 0;
+
+        for (unsigned int y = 0; y < height; ++y) {
+            for (unsigned int x = 0; x < width; ++x) {
+                sf::Color pixel = streamedImage.getPixel(x, y);
+
+                if (pixel != fromMemoryImage.getPixel(x, y)) {
+                    differing++;
+                }
+                if (pixel != sf::Color::Black) {
+                    drawn++;
+                }
+            }
+        }
+
+        // Identical blank frames would mean neither path drew anything
+        bool framePassed = differing == 0 && drawn > 0;
+        passed = passed && framePassed;
+
+        std::cout << "Sprite batch, " << frames[frame] << " quads: " << (framePassed ? "ok" : "FAILED") << " ("
+            << differing << " pixels differ, " << drawn << " drawn)" << std::endl;
+    }
+
+    return passed;
+}
+
+/*
+ *  Queues quads of every loaded texture with random positions, rotations and scales. The
+ *  same seed always queues the same quads.
+ */
+void SelfTest::queueFrame(SpriteBatch& batch, const TextureManager& textureManager, std::size_t quads, unsigned int seed) {
+    random.seed(seed);
+    std::uniform_real_distribution<float> x(0.0f, static_cast<float>(width));
+    std::uniform_real_distribution<float> y(0.0f, static_cast<float>(height));
+    std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 1.5f);
+    const char* names[] = { "Asteroid", "Ship", "Projectile", "EnemyShip" };
+
+    for (std::size_t i = 0; i < quads; ++i) {
+        TextureManager::Handle texture = textureManager.getHandle(names[i % 4]);
+        sf::Vector2u size = textureManager.getTextureSize(texture);
+        sf::Vector2f extent(static_cast<float>(size.x), static_cast<float>(size.y));
+        float factor = scale(random);
+
+        sf::Transform transform;
+        transform.translate(x(random), y(random)).rotate(angle(random)).scale(factor, factor).translate(-extent / 2.0f);
+
+        batch.add(texture, transform, extent);
+    }
+}
+
+sf::Image SelfTest::drawFrame(SpriteBatch& batch, sf::RenderTexture& target) {
+    target.clear(sf::Color::Black);
+    batch.draw(target);
+    target.display();
+    return target.getTexture().copyToImage();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <random>
+#include "Simulation.h"
+#include "SpriteBatch.h"
+#include "TextureManager.h"
+
+/*
+ *  Quick checks of behaviour that is easy to break without noticing, run by --selftest.
+ *  The simulation checks need no graphics at all; the rendering checks need an OpenGL
+ *  context but no window, so they also run under a software driver such as Mesa's
+ *  llvmpipe. A headless run skips the rendering checks.
+ *
+ *  The wrap check places an asteroid that is still flying in, fully off screen above the
+ *  top edge, where its wrapped image would overlap the player at the bottom edge. That
+ *  must not cost a life, while the same asteroid once it wraps does.
+ *
+ *  The hull check places pairs of the shipped textures at random angles and offsets and
+ *  compares CollisionHull against CollisionMask: a simplified hull may report a touch
+ *  the mask does not, but must never miss one the mask finds.
+ *
+ *  The sprite batch check draws the same frames into an sf::RenderTexture twice, once
+ *  streamed through vertex buffers and once from memory, and requires identical pixels.
+ *  Frames grow and then shrink, so the streamed batch also has to grow its buffers and
+ *  ignore vertices left over from a busier frame.
+ */
+class SelfTest {
+public:
+    bool run(bool headless);
+
+private:
+    unsigned int width = 512;
+    unsigned int height = 512;
+
+    std::mt19937 random;
+
+    bool testWrapCollisions();
+    bool spawnEdgeCollides(bool asteroidWraps);
+    bool testHulls();
+
+    bool testSpriteBatch();
+    void queueFrame(SpriteBatch& batch, const TextureManager& textureManager, std::size_t quads, unsigned int seed);
+    sf::Image drawFrame(SpriteBatch& batch, sf::RenderTexture& target);
+};
@@ -0,0 +1,1216 @@
+#include "Simulation.h"
+#include "AllocationCounter.h"
+#include "Profiler.h"
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+/*
+ *  Loads the game's textures and sets up a new session.
+ *
+ *  Parameters:
+ *    worldBounds: The area the game is played in, normally the view bounds. Mobs wrap
+ *                 around its edges and the player starts at its centre.
+ *    seed:        Seeds the generator behind every random choice in the game. Two
+ *                 simulations with the same seed, bounds and inputs stay identical.
+ *    headless:    True to run without a graphics context. Textures are kept on the
+ *                 CPU only, which is all collision needs, and are never drawable.
+ */
+Simulation::Simulation(const sf::FloatRect& worldBounds, unsigned int seed, bool headless)
+    : world(worldBounds),
+    seed(seed),
+    random(seed),
+    frameArena(64 * 1024),
+    players(EntityStore::Type::Player),
+    asteroids(EntityStore::Type::Asteroid),
+    enemyShips(EntityStore::Type::EnemyShip),
+    projectiles(EntityStore::Type::Projectile),
+    asteroidCommands(asteroids, true, &frameArena),
+    enemyShipCommands(enemyShips, true, &frameArena),
+    projectileCommands(projectiles, false, &frameArena),
+    broadphase(&frameArena),
+    broadphaseResults(&frameArena) {
+    textureManager = new TextureManager(!headless);
+
+
+    //Load Textures
+    textureManager->loadTexture("AsteroidFull", "Assets/Asteroid2.png", 10.0f, 10.0f);
+    textureManager->loadTexture("AsteroidHalf", "Assets/Asteroid2.png", 5.0f, 5.0f);
+    textureManager->loadTexture("AsteroidOneFourth", "Assets/Asteroid2.png", 2.5f, 2.5f);
+    textureManager->loadTexture("Laser", "Assets/Laser.png", 2.5f, 2.5f);
+    textureManager->loadTexture("Ship", "Assets/Ship4.png", 5.0f, 5.0f);
+    textureManager->rotateTexture("Ship", -45.0f);
+    textureManager->loadTexture("ShipWithBurner", "Assets/Ship2.png", 5.0f, 5.0f);
+    textureManager->rotateTexture("ShipWithBurner", -45.0f);
+    textureManager->loadTexture("Projectile", "Assets/MissileBig.png", 1.5f, 1.5f);
+    textureManager->loadTexture("EnemyShip", "Assets/EnemyShip.png", 5.0f, 5.0f);
+    textureManager->buildAtlas();
+
+
+    //Set up systems
+    projectileSystem = new ProjectileSystem(*textureManager, world);
+    asteroidSystem = new AsteroidSystem(*textureManager);
+    enemyShipSystem = new EnemyShipSystem(*textureManager, *projectileSystem);
+    playerSystem = new PlayerSystem(*textureManager, *projectileSystem);
+
+    projectiles.setCapacity(maxProjectiles);
+    asteroids.reserve(reservedAsteroids);
+    enemyShips.reserve(reservedEnemyShips);
+    playerSystem->spawn(players);
+    players.setWraps(0);
+
+    // Asteroids, enemy ships and projectiles are close to convex, so hulls are accurate enough.
+    // The player keeps pixel-perfect collision so near misses stay fair.
+    setCollisionMode(EntityStore::Type::Asteroid, CollisionMode::Polygon);
+    setCollisionMode(EntityStore::Type::EnemyShip, CollisionMode::Polygon);
+    setCollisionMode(EntityStore::Type::Projectile, CollisionMode::Polygon);
+    setCollisionMode(EntityStore::Type::Player, CollisionMode::Pixel);
+
+
+    //Set up vars
+    gracePeriodDuration = sf::seconds(3.0);
+    gracePeriodTimer = sf::Time::Zero;
+    inGracePeriod = false;
+    timeSinceLastFire = sf::seconds(static_cast<float>(playerSystem->fireRateInSeconds));
+
+    setUp();
+}
+
+Simulation::~Simulation() {
+
+    delete playerSystem;
+    delete enemyShipSystem;
+    delete asteroidSystem;
+    delete projectileSystem;
+    delete textureManager;
+    //The textures are deleted with textureManager
+}
+
+/*
+ *  Updates the game state based on the time elapsed since the last frame (deltaTime).
+ *  This includes applying the player's input, updating mob positions, checking for collisions,
+ *  and managing game events like spawning asteroids and enemy ships. The function also
+ *  handles game over and the grace period following a collision.
+ *
+ *  Parameters:
+ *    deltaTime: Time elapsed since the last update, used for time-dependent calculations
+ *               like movement, spawning intervals, and the grace period duration.
+ *    input:     The player's controls for this update.
+ *
+ *  Key Actions:
+ *    - Game Over Check: Returns immediately if the game is over, starting a new one if fire is held.
+ *    - Player Input: Fires, thrusts and turns the player (see applyInput).
+ *    - Grace Period Handling: Manages the invulnerability period after the player collides with a mob.
+ *    - Player Update: Processes player movements and actions based on user inputs.
+ *    - Mob Spawning: Periodically spawns asteroids and enemy ships based on timers.
+ *    - Mob Updates: Runs the asteroid and enemy ship systems over their own stores, the latter
+ *                   targeting the player.
+ *    - Screen Wrap: Moves the player and mobs that have left the screen across to the other
+ *                   side (see wrapAround).
+ *    - Projectile Management: Updates projectile positions and removes off-screen projectiles.
+ *    - Collision Detection: Builds the broadphase grid (see collide), then only runs collides on
+ *                           pairs sharing a cell, applying game logic like splitting asteroids
+ *                           and removing lives.
+ *    - Flush: Spawns and destroys requested by the steps above go through each store's
+ *             command buffer, so the stores don't change while they are being iterated.
+ *             Both are applied in bulk once everything else has run.
+ *    - Frame Memory: Everything that only lives for this update is allocated from
+ *                    frameArena, which is reset on entry and handed back before returning,
+ *                    so a steady-state update makes no heap allocations.
+ *
+ *  Note:
+ *    The function ensures that all game logic is processed in a consistent manner, adhering
+ *    to the fixed time step defined by deltaTime. This approach provides a stable and uniform
+ *    gameplay experience across different hardware.
+ */
+void Simulation::update(sf::Time deltaTime, const PlayerInput& input) {
+    frameArena.reset();
+
+    //Stop Updates, firing starts a new game
+    if (gameOver) {
+        if (input.fire) {
+            setUp();
+        }
+        return;
+    }
+
+    applyInput(deltaTime, input);
+
+    if (inGracePeriod) {
+        gracePeriodTimer += deltaTime;
+        if (gracePeriodTimer >= gracePeriodDuration) {
+            inGracePeriod = false;
+            gracePeriodTimer = sf::Time::Zero;
+        }
+    }
+
+    playerSystem->update(players, deltaTime);
+
+    {
+        PROFILE_SCOPE("Spawn");
+        asteroidSpawnTimer += deltaTime;
+        enemyShipSpawnTimer += deltaTime;
+
+        if (asteroidSpawnTimer.asSeconds() >= 7) {
+            spawnMob(EntityStore::Type::Asteroid);
+            asteroidSpawnTimer = sf::Time::Zero;
+        }
+
+        if (enemyShipSpawnTimer.asSeconds() >= 25) {
+            spawnMob(EntityStore::Type::EnemyShip);
+            enemyShipSpawnTimer = sf::Time::Zero;
+        }
+    }
+
+    {
+        PROFILE_SCOPE("Mob update");
+        asteroidSystem->update(asteroids, deltaTime);
+        enemyShipSystem->update(enemyShips, projectileCommands, deltaTime, players.position[0]);
+
+        settleOnScreen(asteroids);
+        settleOnScreen(enemyShips);
+    }
+
+    // Bring anything that wraps back onto the screen once its centre has left it
+    {
+        PROFILE_SCOPE("Wrap");
+        wrapAround(players);
+        wrapAround(asteroids);
+        wrapAround(enemyShips);
+    }
+
+    // Move projectiles and destroy any that have left the screen, which keeps them out of the broadphase
+    {
+        PROFILE_SCOPE("Projectile update");
+        projectileSystem->update(projectiles, asteroids, enemyShips, deltaTime);
+
+        const sf::FloatRect& worldBounds = world.getBounds();
+
+        for (std::size_t i = 0; i < projectiles.size(); ++i) {
+            sf::Vector2f projectilePos = projectiles.position[i];
+            if (projectilePos.x < worldBounds.left || projectilePos.x > worldBounds.left + worldBounds.width ||
+                projectilePos.y < worldBounds.top || projectilePos.y > worldBounds.top + worldBounds.height) {
+                projectileCommands.destroy(i);
+            }
+        }
+    }
+
+    collide();
+
+    // Apply everything requested this tick. Mobs keep their order; projectile order doesn't
+    // matter, so they are swapped out of the pool in constant time each.
+    {
+        PROFILE_SCOPE("Flush");
+        asteroidCommands.flush();
+        enemyShipCommands.flush();
+        projectileCommands.flush();
+    }
+
+    // Nothing may point into the arena once the tick is over
+    broadphase.release();
+    std::pmr::vector<std::size_t>(&frameArena).swap(broadphaseResults);
+}
+
+/*
+ *  Builds the broadphase and runs every collision check for this tick: the player against
+ *  mobs and hostile projectiles, then the player's projectiles against mobs. Hits only
+ *  request destroys and splits through the command buffers, so the stores stay as they
+ *  are until update flushes them.
+ */
+void Simulation::collide() {
+    AllocationCounter::Scope scope(AllocationCounter::Phase::Collision);
+    PROFILE_SCOPE("Collision");
+
+    buildBroadphase();
+
+    {
+        PROFILE_SCOPE("Player vs mob");
+        // Player against mobs sharing a cell
+        if (!inGracePeriod) {
+            collidePlayer(asteroids, asteroidCommands, AsteroidLayer, true);
+        }
+
+        if (!inGracePeriod) {
+            collidePlayer(enemyShips, enemyShipCommands, EnemyShipLayer, false);
+        }
+
+        // Player against enemy projectiles sharing a cell
+        if (!inGracePeriod) {
+            broadphaseResults.clear();
+            broadphase.queryRect(players.getBounds(0), ProjectileLayer, broadphaseResults, players.wraps[0] != 0);
+            std::sort(broadphaseResults.begin(), broadphaseResults.end());
+
+            for (std::size_t projectileIndex : broadphaseResults) {
+                if (inGracePeriod || gameOver) {
+                    break;
+                }
+
+                if (projectiles.hostile[projectileIndex] &&
+                    sweptCollision(projectiles, projectileIndex, players, 0, wrapOffset(projectiles, projectileIndex, players, 0))) {
+                    removeLife();
+                    projectileCommands.destroy(projectileIndex);
+                }
+            }
+        }
+    }
+
+    // Player projectiles against mobs sharing a cell, each projectile destroys at most one mob
+    {
+        PROFILE_SCOPE("Projectile loop");
+        for (std::size_t projectileIndex = 0; projectileIndex < projectiles.size(); ++projectileIndex) {
+            if (projectiles.hostile[projectileIndex] || projectileCommands.isDestroyed(projectileIndex)) {
+                continue;
+            }
+
+            if (!collideProjectile(projectileIndex, asteroids, asteroidCommands, AsteroidLayer, true)) {
+                collideProjectile(projectileIndex, enemyShips, enemyShipCommands, EnemyShipLayer, false);
+            }
+        }
+    }
+}
+
+/*
+ *  Checks the player against every mob in a store that shares a broadphase cell with it,
+ *  destroying the mobs it hits and taking a life for each. Stops as soon as the player
+ *  is in its grace period or the game is over.
+ *
+ *  Parameters:
+ *    mobs:     The store to check, all of one type.
+ *    commands: The store's command buffer.
+ *    layer:    The broadphase layer the store's mobs were inserted on.
+ *    splits:   True if the mobs are asteroids, which split when destroyed.
+ */
+void Simulation::collidePlayer(EntityStore& mobs, CommandBuffer& commands, CollisionLayer layer, bool splits) {
+    broadphaseResults.clear();
+    broadphase.queryRect(players.getBounds(0), layer, broadphaseResults, players.wraps[0] != 0);
+    std::sort(broadphaseResults.begin(), broadphaseResults.end());
+
+    for (std::size_t mobIndex : broadphaseResults) {
+        if (inGracePeriod || gameOver) {
+            break;
+        }
+
+        if (collides(players, 0, mobs, mobIndex, wrapOffset(players, 0, mobs, mobIndex))) {
+
+            removeLife();
+
+            if (splits) {
+                asteroidSystem->split(mobs, mobIndex, commands, random);
+            }
+
+            commands.destroy(mobIndex);
+        }
+    }
+}
+
+/*
+ *  Checks one of the player's projectiles against every mob in a store that its path this
+ *  tick shares a broadphase cell with. The first mob hit is destroyed along with the
+ *  projectile, and scores 100.
+ *
+ *  Parameters:
+ *    projectile: The projectile to check.
+ *    mobs:       The store to check it against, all of one type.
+ *    commands:   The store's command buffer.
+ *    layer:      The broadphase layer the store's mobs were inserted on.
+ *    splits:     True if the mobs are asteroids, which split when destroyed.
+ *
+ *  Returns:
+ *    bool: True if the projectile hit a mob.
+ */
+bool Simulation::collideProjectile(std::size_t projectile, EntityStore& mobs, CommandBuffer& commands, CollisionLayer layer, bool splits) {
+    broadphaseResults.clear();
+    broadphase.queryRect(sweptBounds(projectile), layer, broadphaseResults, projectiles.wraps[projectile] != 0);
+    std::sort(broadphaseResults.begin(), broadphaseResults.end());
+
+    for (std::size_t mobIndex : broadphaseResults) {
+        if (commands.isDestroyed(mobIndex)) {
+            continue;
+        }
+
+        if (sweptCollision(projectiles, projectile, mobs, mobIndex, wrapOffset(projectiles, projectile, mobs, mobIndex))) {
+            score += 100;
+
+            if (splits) {
+                asteroidSystem->split(mobs, mobIndex, commands, random);
+            }
+
+            commands.destroy(mobIndex);
+            projectileCommands.destroy(projectile);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ *  Applies the player's controls for one update. Firing is limited by the player's fire
+ *  rate, and thrust and turning also drive the player's animation and drag.
+ *
+ *  Parameters:
+ *    deltaTime: Time elapsed since the last update.
+ *    input:     The controls held during this update.
+ */
+void Simulation::applyInput(sf::Time deltaTime, const PlayerInput& input) {
+
+    const sf::Time fireRate = sf::seconds(static_cast<float>(playerSystem->fireRateInSeconds));
+
+    if (input.fire && timeSinceLastFire >= fireRate) {
+        playerSystem->fire(players, projectileCommands, asteroids, enemyShips);
+        timeSinceLastFire = sf::Time::Zero;
+    }
+
+    sf::Vector2f acceleration(0.0f, 0.0f);
+
+    if (input.thrust) {
+        acceleration.y -= 300.0f; // Move up
+    }
+
+    if (input.turnLeft) {
+        playerSystem->setRotation(players, false, deltaTime); //Rotate left
+    }
+
+    if (input.turnRight) {
+        playerSystem->setRotation(players, true, deltaTime); //Rotate right
+    }
+
+    playerSystem->setAcceleration(acceleration);
+    playerSystem->setMoving(input.thrust);
+    playerSystem->setTurning(input.turnLeft || input.turnRight);
+
+    timeSinceLastFire += deltaTime;
+}
+
+/*
+ *  Returns the area the game is played in. Resizing it takes effect for every entity
+ *  at once, including those already wrapping.
+ */
+World& Simulation::getWorld() {
+    return world;
+}
+
+/*
+ *  Returns the store holding the player's ship, always entity 0.
+ */
+EntityStore& Simulation::getPlayers() {
+    return players;
+}
+
+EntityStore& Simulation::getProjectiles() {
+    return projectiles;
+}
+
+EntityStore& Simulation::getAsteroids() {
+    return asteroids;
+}
+
+EntityStore& Simulation::getEnemyShips() {
+    return enemyShips;
+}
+
+const TextureManager& Simulation::getTextureManager() const {
+    return *textureManager;
+}
+
+int Simulation::getScore() const {
+    return score;
+}
+
+int Simulation::getLives() const {
+    return lives;
+}
+
+bool Simulation::isGameOver() const {
+    return gameOver;
+}
+
+bool Simulation::isInGracePeriod() const {
+    return inGracePeriod;
+}
+
+sf::Time Simulation::getGracePeriodTimer() const {
+    return gracePeriodTimer;
+}
+
+unsigned int Simulation::getSeed() const {
+    return seed;
+}
+
+/*
+ *  Returns the arena tick-local data is allocated from, e.g. to report its peak use.
+ */
+const FrameArena& Simulation::getFrameArena() const {
+    return frameArena;
+}
+
+/*
+ *  Returns a 64-bit FNV-1a hash of everything that affects how the game plays out: the
+ *  score, lives and timers, and the exact position, velocity and rotation bits of the
+ *  player, every mob and every projectile. Two runs that stay in step have equal hashes
+ *  after every update, so comparing them is enough to check a replay or a benchmark
+ *  run is deterministic.
+ */
+std::uint64_t Simulation::stateHash() const {
+    std::uint64_t hash = 14695981039346656037ull;
+
+    auto mix = [&hash](const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    auto mixFloat = [&mix](float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        mix(&bits, sizeof(bits));
+    };
+
+    auto mixStore = [&mix, &mixFloat](const EntityStore& store) {
+        int type = static_cast<int>(store.getType());
+        mix(&type, sizeof(type));
+
+        for (std::size_t i = 0; i < store.size(); ++i) {
+            mixFloat(store.position[i].x);
+            mixFloat(store.position[i].y);
+            mixFloat(store.velocity[i].x);
+            mixFloat(store.velocity[i].y);
+            mixFloat(store.rotation[i]);
+        }
+    };
+
+    mix(&score, sizeof(score));
+    mix(&lives, sizeof(lives));
+    mix(&gameOver, sizeof(gameOver));
+    mix(&inGracePeriod, sizeof(inGracePeriod));
+
+    sf::Int64 timers[4] = { gracePeriodTimer.asMicroseconds(), asteroidSpawnTimer.asMicroseconds(),
+        enemyShipSpawnTimer.asMicroseconds(), timeSinceLastFire.asMicroseconds() };
+    mix(timers, sizeof(timers));
+
+    mixStore(players);
+    mixStore(asteroids);
+    mixStore(enemyShips);
+    mixStore(projectiles);
+
+    return hash;
+}
+
+/*
+ *  Returns a random integer in [0, max) from the simulation's own generator.
+ */
+int Simulation::randomInt(int max) {
+    return static_cast<int>(random() % static_cast<unsigned int>(max));
+}
+
+/*
+ *  Checks whether two entities collide, escalating through progressively more expensive tests.
+ *  The pair first has to pass a bounding circle test and then an oriented box test
+ *  (see circleCollision and orientedBoxCollision). The final test depends on the
+ *  collision mode selected for each entity's type: if both use CollisionMode::Polygon their
+ *  convex hulls are compared (polygonCollision), otherwise their collision masks are
+ *  (pixelPerfectCollision).
+ *
+ *  Every call is counted in collisionStats by the tier that rejected it (see testCollision).
+ *
+ *  Parameters:
+ *    store1, index1: The first entity involved in the collision check.
+ *    store2, index2: The second entity involved in the collision check.
+ *    offset2:        Translation applied to the second entity before testing, used to test
+ *                    against its wrapped copy on the far side of the screen.
+ *
+ *  Returns:
+ *    bool: True if the entities collide, false otherwise.
+ */
+bool Simulation::collides(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+    const sf::Vector2f& offset2) {
+
+    CollisionOutcome outcome = testCollision(store1, index1, store2, index2, offset2);
+    countCollision(outcome);
+    return outcome == CollisionOutcome::Hit;
+}
+
+/*
+ *  Runs collides' tests on a pair without counting them in collisionStats, so callers that
+ *  test one pair several times can count it once.
+ *
+ *  Returns:
+ *    CollisionOutcome: The tier that rejected the pair, Hit if none did, or NotSolid if
+ *                      either entity is not solid and nothing was tested.
+ */
+Simulation::CollisionOutcome Simulation::testCollision(const EntityStore& store1, std::size_t index1,
+    const EntityStore& store2, std::size_t index2, const sf::Vector2f& offset2) {
+
+    if (!store1.solid[index1] || !store2.solid[index2]) {
+        return CollisionOutcome::NotSolid;
+    }
+
+    // Midphase: cheap bounding circles first, then the oriented texture rectangles
+    if (!circleCollision(store1, index1, store2, index2, offset2)) {
+        return CollisionOutcome::CircleRejected;
+    }
+
+    if (!orientedBoxCollision(store1, index1, store2, index2, offset2)) {
+        return CollisionOutcome::BoxRejected;
+    }
+
+    if (getCollisionMode(store1.getType()) == CollisionMode::Polygon && getCollisionMode(store2.getType()) == CollisionMode::Polygon) {
+        if (!polygonCollision(store1, index1, store2, index2, offset2)) {
+            return CollisionOutcome::HullRejected;
+        }
+    }
+    else if (!pixelPerfectCollision(store1, index1, store2, index2, offset2)) {
+        return CollisionOutcome::MaskRejected;
+    }
+
+    return CollisionOutcome::Hit; // Collision detected
+}
+
+/*
+ *  Counts one tested pair in collisionStats under its outcome. Pairs that were not solid
+ *  were never tested and are not counted.
+ */
+void Simulation::countCollision(CollisionOutcome outcome) {
+    if (outcome == CollisionOutcome::NotSolid) {
+        return;
+    }
+
+    collisionStats.pairs++;
+
+    switch (outcome) {
+    case CollisionOutcome::CircleRejected:
+        collisionStats.circleRejected++;
+        break;
+    case CollisionOutcome::BoxRejected:
+        collisionStats.boxRejected++;
+        break;
+    case CollisionOutcome::MaskRejected:
+        collisionStats.maskRejected++;
+        break;
+    case CollisionOutcome::HullRejected:
+        collisionStats.hullRejected++;
+        break;
+    default:
+        collisionStats.hits++;
+        break;
+    }
+}
+
+/*
+ *  Checks whether a projectile hit an entity at any point along the path it covered during the
+ *  last update, rather than only at its final position. The path from the projectile's
+ *  previous position is sampled at intervals no longer than the projectile's smallest
+ *  dimension, so consecutive samples overlap and even small, fast-moving pairs cannot
+ *  pass through each other between ticks. Samples are tested in order, earliest first.
+ *
+ *  Falls back to a single collides test when continuousCollision is disabled. Either way the
+ *  pair is counted once in collisionStats: as a hit if any sample hit, otherwise under the
+ *  furthest tier any sample reached, with a miss of the whole path counting as a circle
+ *  rejection.
+ *
+ *  Parameters:
+ *    projectiles, projectile: The moving projectile.
+ *    store, index:            The entity it may have hit.
+ *    offset:                  Translation applied to the entity before testing, as for collides.
+ *
+ *  Returns:
+ *    bool: True if the projectile touched the entity anywhere along its path.
+ */
+bool Simulation::sweptCollision(const EntityStore& projectiles, std::size_t projectile, const EntityStore& store, std::size_t index,
+    const sf::Vector2f& offset) {
+
+    sf::Vector2f travel = projectiles.position[projectile] - projectiles.previousPosition[projectile];
+    float distance = std::sqrt(travel.x * travel.x + travel.y * travel.y);
+
+    if (!continuousCollision || distance <= 0.0f) {
+        return collides(projectiles, projectile, store, index, offset);
+    }
+
+    // Skip pairs whose bounding circles never meet along the path
+    sf::Vector2f projectileCentre, mobCentre;
+    float projectileRadius, mobRadius;
+    boundingCircle(projectiles, projectile, projectileCentre, projectileRadius);
+    boundingCircle(store, index, mobCentre, mobRadius);
+    mobCentre += offset;
+
+    sf::Vector2f start = projectileCentre - travel;
+    sf::Vector2f toMob = mobCentre - start;
+    float along = std::max(0.0f, std::min(1.0f, (toMob.x * travel.x + toMob.y * travel.y) / (distance * distance)));
+    sf::Vector2f closest = start + travel * along - mobCentre;
+    float reach = projectileRadius + mobRadius;
+
+    if (closest.x * closest.x + closest.y * closest.y > reach * reach) {
+        countCollision(projectiles.solid[projectile] && store.solid[index] ? CollisionOutcome::CircleRejected : CollisionOutcome::NotSolid);
+        return false;
+    }
+
+    sf::Vector2f local = projectiles.extent[projectile];
+    float step = std::max(1.0f, std::min(local.x, local.y));
+    int samples = std::max(1, static_cast<int>(std::ceil(distance / step)));
+
+    // Moving the entity back along the path is the same as moving the projectile forward along it
+    CollisionOutcome furthest = CollisionOutcome::NotSolid;
+
+    for (int i = 1; i <= samples && furthest != CollisionOutcome::Hit; i++) {
+        float remaining = 1.0f - static_cast<float>(i) / samples;
+        furthest = std::max(furthest, testCollision(projectiles, projectile, store, index, offset + travel * remaining));
+    }
+
+    countCollision(furthest);
+    return furthest == CollisionOutcome::Hit;
+}
+
+/*
+ *  Checks for pixel-perfect collision between two entities using their textures' collision masks.
+ *  This function first performs a bounding box collision check. If the bounding boxes
+ *  intersect, it then tests the bit-packed masks the TextureManager built at load time
+ *  against each other a 64-pixel word at a time. A collision is detected if two solid
+ *  pixels (alpha above CollisionMask::ALPHA_THRESHOLD) overlap.
+ *
+ *  Parameters:
+ *    store1, index1: The first entity involved in the collision check.
+ *    store2, index2: The second entity involved in the collision check.
+ *    offset2:        Translation applied to the second entity before testing.
+ *
+ *  Returns:
+ *    bool: True if a pixel-perfect collision is detected, false otherwise.
+ *
+ *  Note:
+ *    Rotated or scaled pairs resample the smaller mask into the larger one row by row,
+ *    so the cost grows with the smaller sprite's area rather than the intersection.
+ */
+bool Simulation::pixelPerfectCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+    const sf::Vector2f& offset2) {
+
+    if (!store1.solid[index1] || !store2.solid[index2]) {
+        return false;
+    }
+
+    sf::FloatRect bounds2 = store2.getBounds(index2);
+    bounds2.left += offset2.x;
+    bounds2.top += offset2.y;
+
+    if (!store1.getBounds(index1).intersects(bounds2)) {
+        return false;
+    }
+
+    return CollisionMask::overlap(textureManager->getCollisionMask(store1.texture[index1]), textureTransform(store1, index1, sf::Vector2f(0.0f, 0.0f)),
+        textureManager->getCollisionMask(store2.texture[index2]), textureTransform(store2, index2, offset2));
+}
+
+/*
+ *  Checks for collision between two entities using the convex hulls the TextureManager derived
+ *  from their textures' alpha channels. This is a separating axis test over a handful of
+ *  vertices, so it is much cheaper than pixelPerfectCollision and close to it in accuracy
+ *  for the nearly convex asteroid and ship sprites.
+ *
+ *  Parameters:
+ *    store1, index1: The first entity involved in the collision check.
+ *    store2, index2: The second entity involved in the collision check.
+ *    offset2:        Translation applied to the second entity before testing.
+ *
+ *  Returns:
+ *    bool: True if the hulls overlap, false otherwise.
+ */
+bool Simulation::polygonCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+    const sf::Vector2f& offset2) {
+
+    if (!store1.solid[index1] || !store2.solid[index2]) {
+        return false;
+    }
+
+    return CollisionHull::overlap(textureManager->getCollisionHull(store1.texture[index1]), textureTransform(store1, index1, sf::Vector2f(0.0f, 0.0f)),
+        textureManager->getCollisionHull(store2.texture[index2]), textureTransform(store2, index2, offset2));
+}
+
+/*
+ *  Selects how entities of the given type are tested once they pass the midphase. A pair is
+ *  only tested with hulls when both types use CollisionMode::Polygon.
+ */
+void Simulation::setCollisionMode(EntityStore::Type type, CollisionMode mode) {
+    collisionModes[static_cast<int>(type)] = mode;
+}
+
+Simulation::CollisionMode Simulation::getCollisionMode(EntityStore::Type type) const {
+    return collisionModes[static_cast<int>(type)];
+}
+
+/*
+ *  Checks for a bounding box collision between two entities. This method is a
+ *  simpler and less computationally intensive approach compared to pixel-perfect
+ *  collision detection. It's based on comparing the axis-aligned bounding boxes
+ *  (AABB) of each entity to see if they intersect.
+ *
+ *  Parameters:
+ *    store1, index1: The first entity involved in the collision check.
+ *    store2, index2: The second entity involved in the collision check.
+ *
+ *  Returns:
+ *    bool: True if the bounding boxes of the two entities intersect, indicating a collision.
+ *          False if they do not intersect or if either is set to not have collisions.
+ */
+bool Simulation::boundingBoxCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2) {
+
+    if (!store1.solid[index1] || !store2.solid[index2]) {
+        return false;
+    }
+
+    sf::FloatRect bounds1 = store1.getBounds(index1);
+    sf::FloatRect bounds2 = store2.getBounds(index2);
+
+    return bounds1.intersects(bounds2);
+}
+
+/*
+ *  Checks whether the bounding circles of two entities overlap. Each circle is centred on
+ *  the middle of the entity's texture rectangle and encloses it at any rotation, so this
+ *  is the cheapest test that still rejects most pairs whose axis-aligned boxes touch.
+ *
+ *  Parameters:
+ *    store1, index1: The first entity involved in the collision check.
+ *    store2, index2: The second entity involved in the collision check.
+ *    offset2:        Translation applied to the second entity before testing.
+ *
+ *  Returns:
+ *    bool: True if the circles overlap and both entities have collisions enabled.
+ */
+bool Simulation::circleCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+    const sf::Vector2f& offset2) {
+
+    if (!store1.solid[index1] || !store2.solid[index2]) {
+        return false;
+    }
+
+    sf::Vector2f centre1, centre2;
+    float radius1, radius2;
+    boundingCircle(store1, index1, centre1, radius1);
+    boundingCircle(store2, index2, centre2, radius2);
+
+    sf::Vector2f distance = centre2 + offset2 - centre1;
+    float radii = radius1 + radius2;
+
+    return distance.x * distance.x + distance.y * distance.y <= radii * radii;
+}
+
+/*
+ *  Checks whether the oriented bounding boxes of two entities overlap using the separating
+ *  axis theorem. The boxes are the entities' texture rectangles put through their full
+ *  transforms, so unlike getBounds() they stay tight for rotated ships and projectiles.
+ *
+ *  Parameters:
+ *    store1, index1: The first entity involved in the collision check.
+ *    store2, index2: The second entity involved in the collision check.
+ *    offset2:        Translation applied to the second entity before testing.
+ *
+ *  Returns:
+ *    bool: True if no separating axis exists and both entities have collisions enabled.
+ */
+bool Simulation::orientedBoxCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+    const sf::Vector2f& offset2) {
+
+    if (!store1.solid[index1] || !store2.solid[index2]) {
+        return false;
+    }
+
+    sf::Vector2f corners1[4];
+    sf::Vector2f corners2[4];
+    orientedBox(store1, index1, sf::Vector2f(0.0f, 0.0f), corners1);
+    orientedBox(store2, index2, offset2, corners2);
+
+    // The candidate axes are the two edge directions of each box
+    const sf::Vector2f axes[4] = {
+        corners1[1] - corners1[0], corners1[3] - corners1[0],
+        corners2[1] - corners2[0], corners2[3] - corners2[0]
+    };
+
+    for (const sf::Vector2f& axis : axes) {
+        float min1 = std::numeric_limits<float>::max(), max1 = std::numeric_limits<float>::lowest();
+        float min2 = std::numeric_limits<float>::max(), max2 = std::numeric_limits<float>::lowest();
+
+        for (int i = 0; i < 4; i++) {
+            float projection1 = corners1[i].x * axis.x + corners1[i].y * axis.y;
+            float projection2 = corners2[i].x * axis.x + corners2[i].y * axis.y;
+            min1 = std::min(min1, projection1);
+            max1 = std::max(max1, projection1);
+            min2 = std::min(min2, projection2);
+            max2 = std::max(max2, projection2);
+        }
+
+        if (max1 < min2 || max2 < min1) {
+            return false; // Separating axis found
+        }
+    }
+
+    return true;
+}
+
+/*
+ *  Computes the circle enclosing an entity's texture rectangle in world space. Entities
+ *  rotate about their centre, so the circle is centred on their position.
+ */
+void Simulation::boundingCircle(const EntityStore& store, std::size_t index, sf::Vector2f& centre, float& radius) const {
+    sf::Vector2f size = store.extent[index];
+
+    centre = store.position[index];
+    radius = 0.5f * std::sqrt(size.x * size.x + size.y * size.y);
+}
+
+/*
+ *  Returns the transform from an entity's texture pixel coordinates to world coordinates,
+ *  shifted by offset. Collision masks and hulls cover the whole texture, so this is the
+ *  entity's own transform.
+ */
+sf::Transform Simulation::textureTransform(const EntityStore& store, std::size_t index, const sf::Vector2f& offset) const {
+    sf::Transform transform;
+    transform.translate(offset);
+    transform.combine(store.getTransform(index));
+    return transform;
+}
+
+/*
+ *  Computes the four world-space corners of an entity's texture rectangle, in winding order.
+ */
+void Simulation::orientedBox(const EntityStore& store, std::size_t index, const sf::Vector2f& offset, sf::Vector2f corners[4]) const {
+    sf::Vector2f size = store.extent[index];
+    sf::Transform transform = store.getTransform(index);
+
+    corners[0] = transform.transformPoint(0.0f, 0.0f) + offset;
+    corners[1] = transform.transformPoint(size.x, 0.0f) + offset;
+    corners[2] = transform.transformPoint(size.x, size.y) + offset;
+    corners[3] = transform.transformPoint(0.0f, size.y) + offset;
+}
+
+/*
+ *  Rebuilds the broadphase grid from the current mobs and projectiles. The grid is laid
+ *  over the world bounds and split into broadphaseDivisions cells along its longer side,
+ *  so it follows the view when the window is resized.
+ *
+ *  Each store is inserted on its own layer (AsteroidLayer, EnemyShipLayer and
+ *  ProjectileLayer) with its index in that store as the id, so a query on one layer
+ *  returns indices into one store. Anything already destroyed this tick is left out.
+ *  Projectiles are inserted with the bounds of the whole path they covered this tick
+ *  (see sweptBounds). With wrapCollisions enabled the grid is toroidal and every entity
+ *  that wraps on screen is registered in the cells on both sides of any edge it straddles.
+ */
+void Simulation::buildBroadphase() {
+    PROFILE_SCOPE("Broadphase");
+    const sf::FloatRect& worldBounds = world.getBounds();
+    float cellSize = std::max(worldBounds.width, worldBounds.height) / broadphaseDivisions;
+    broadphase.reset(worldBounds, cellSize, wrapCollisions);
+
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        if (!asteroidCommands.isDestroyed(i)) {
+            broadphase.insert(i, asteroids.getBounds(i), AsteroidLayer, asteroids.wraps[i] != 0);
+        }
+    }
+
+    for (std::size_t i = 0; i < enemyShips.size(); ++i) {
+        if (!enemyShipCommands.isDestroyed(i)) {
+            broadphase.insert(i, enemyShips.getBounds(i), EnemyShipLayer, enemyShips.wraps[i] != 0);
+        }
+    }
+
+    for (std::size_t i = 0; i < projectiles.size(); ++i) {
+        if (!projectileCommands.isDestroyed(i)) {
+            broadphase.insert(i, sweptBounds(i), ProjectileLayer, projectiles.wraps[i] != 0);
+        }
+    }
+}
+
+/*
+ *  Returns the axis-aligned bounds of everything a projectile covered during the last
+ *  update: the union of its bounds at its previous and current positions. Just its
+ *  current bounds when continuousCollision is disabled.
+ */
+sf::FloatRect Simulation::sweptBounds(std::size_t projectile) const {
+    sf::FloatRect bounds = projectiles.getBounds(projectile);
+
+    if (!continuousCollision) {
+        return bounds;
+    }
+
+    sf::Vector2f travel = projectiles.position[projectile] - projectiles.previousPosition[projectile];
+    float left = std::min(bounds.left, bounds.left - travel.x);
+    float top = std::min(bounds.top, bounds.top - travel.y);
+
+    return sf::FloatRect(left, top, bounds.width + std::fabs(travel.x), bounds.height + std::fabs(travel.y));
+}
+
+/*
+ *  Returns the translation that moves the target entity onto its wrapped copy nearest the
+ *  source entity, for passing to collides. Zero unless the broadphase is wrapping and at
+ *  least one of the pair wraps on screen. If only one of them wraps, the other can only
+ *  touch the copies of it that are drawn, across an edge it straddles, so a mob still
+ *  flying in off screen is never hit through the opposite edge.
+ */
+sf::Vector2f Simulation::wrapOffset(const EntityStore& fromStore, std::size_t from, const EntityStore& toStore, std::size_t to) const {
+    bool fromWraps = fromStore.wraps[from] != 0;
+    bool toWraps = toStore.wraps[to] != 0;
+
+    if (!fromWraps && !toWraps) {
+        return sf::Vector2f(0.0f, 0.0f);
+    }
+
+    sf::Vector2f offset = broadphase.wrapOffset(fromStore.position[from], toStore.position[to]);
+
+    if (!fromWraps) {
+        return broadphase.drawnCopyShift(toStore.getBounds(to), offset);
+    }
+
+    if (!toWraps) {
+        return -broadphase.drawnCopyShift(fromStore.getBounds(from), -offset);
+    }
+
+    return offset;
+}
+
+/*
+ *  Makes every mob in a store that has come fully on screen start wrapping around the
+ *  world bounds, so mobs don't warp while they are still flying in after spawning.
+ */
+void Simulation::settleOnScreen(EntityStore& mobs) {
+    for (std::size_t i = 0; i < mobs.size(); ++i) {
+        if (!mobs.wraps[i] && isFullyOnScreen(mobs, i)) {
+            mobs.setWraps(i);
+        }
+    }
+}
+
+/*
+ *  Moves every wrapping entity in a store whose centre has left the world bounds across
+ *  to the opposite edge. This is the only place positions wrap, once per update, so a
+ *  run plays out the same however often, or whether, it is drawn. Entities that straddle
+ *  an edge without their centre crossing it stay put; the renderer draws their copies.
+ */
+void Simulation::wrapAround(EntityStore& store) {
+    const sf::FloatRect& bounds = world.getBounds();
+    float right = bounds.left + bounds.width;
+    float bottom = bounds.top + bounds.height;
+
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        if (!store.wraps[i]) {
+            continue;
+        }
+
+        sf::Vector2f& position = store.position[i];
+
+        if (position.x < bounds.left) {
+            position.x += bounds.width;
+        }
+        else if (position.x > right) {
+            position.x -= bounds.width;
+        }
+
+        if (position.y < bounds.top) {
+            position.y += bounds.height;
+        }
+        else if (position.y > bottom) {
+            position.y -= bounds.height;
+        }
+    }
+}
+
+/*
+ *  Returns the narrowphase counters gathered since they were last reset.
+ */
+const Simulation::CollisionStats& Simulation::getCollisionStats() const {
+    return collisionStats;
+}
+
+void Simulation::resetCollisionStats() {
+    collisionStats = CollisionStats();
+}
+
+/*
+ *  Checks if a given entity is within the current screen view.
+ *
+ *  Parameters:
+ *    store, index: The entity to check for partial visibility.
+ *
+ *  Returns:
+ *    bool: True if the entity's bounding box intersects with the world bounds, indicating it's on screen.
+ *          False otherwise.
+ */
+bool Simulation::isOnScreen(const EntityStore& store, std::size_t index) {
+    return world.getBounds().intersects(store.getBounds(index));
+}
+
+/*
+ *  Determines if an entity is completely within the current screen view, without any part
+ *  of it extending beyond the view boundaries.
+ *
+ *  Parameters:
+ *    store, index: The entity to check for complete visibility.
+ *
+ *  Returns:
+ *    bool: True if the entire entity is within the world bounds, ensuring no part is off-screen.
+ *          False if any part of the entity extends beyond the world bounds.
+ *
+ *  This function is useful for determining whether an entity should start wrapping,
+ *  making sure it doesn't warp after spawning
+ */
+bool Simulation::isFullyOnScreen(const EntityStore& store, std::size_t index) {
+    const sf::FloatRect& worldBounds = world.getBounds();
+    sf::FloatRect mobBounds = store.getBounds(index);
+
+    sf::Vector2f mobCenter = store.position[index];
+    mobBounds.left = mobCenter.x - mobBounds.width / 2.0f;
+    mobBounds.top = mobCenter.y - mobBounds.height / 2.0f;
+
+    bool isLeftEdgeInside = mobBounds.left >= worldBounds.left;
+    bool isRightEdgeInside = mobBounds.left + mobBounds.width <= worldBounds.left + worldBounds.width;
+    bool isTopEdgeInside = mobBounds.top >= worldBounds.top;
+    bool isBottomEdgeInside = mobBounds.top + mobBounds.height <= worldBounds.top + worldBounds.height;
+
+    return isLeftEdgeInside && isRightEdgeInside && isTopEdgeInside && isBottomEdgeInside;
+}
+
+
+/*
+ *  Spawns a new mob of the specified type at a random location just outside the view boundaries,
+ *  with a randomised velocity and direction. The spawn location is determined by randomly selecting
+ *  one of the four edges of the screen (top, right, bottom, left).
+ *
+ *  Parameters:
+ *    type: The type of mob to spawn, EntityStore::Type::Asteroid or EntityStore::Type::EnemyShip.
+ *
+ *  Functionality:
+ *    - Randomly selects a spawn side and calculates a corresponding start position just off-screen.
+ *    - Sets a base speed and applies a random angle deviation to give the mob a varied velocity.
+ *    - Requests the mob through the system for its type; it joins that type's store when
+ *      the store's command buffer is next flushed.
+ */
+void Simulation::spawnMob(EntityStore::Type type) {
+
+    const sf::FloatRect& worldBounds = world.getBounds();
+    int side = randomInt(4); // 0 = top, 1 = right, 2 = bottom, 3 = left
+    sf::Vector2f startPosition;
+    sf::Vector2f velocity;
+
+    float baseSpeed = 500.0f;
+
+    // Angle deviation within 80 degrees (in radians)
+    float angleDeviation = static_cast<float>((randomInt(160) - 80) * PI / 180.0);
+
+    EntityStore* spawns;
+    std::size_t newMob;
+
+    // Initialise the new mob based on its type
+    switch (type) {
+    case EntityStore::Type::Asteroid:
+        spawns = &asteroidCommands.spawns();
+        newMob = asteroidSystem->spawn(*spawns, 2);
+        break;
+    case EntityStore::Type::EnemyShip:
+        spawns = &enemyShipCommands.spawns();
+        newMob = enemyShipSystem->spawn(*spawns);
+        break;
+    default:
+        std::cerr << "Unsupported Mob Type" << std::endl;
+        return; // Early return if the type is not supported
+    }
+
+    sf::FloatRect mobBounds = spawns->getBounds(newMob);
+
+    // Determine startPosition and velocity based on the chosen side
+    switch (side) {
+    case 0: // Top
+        startPosition.x = worldBounds.left + static_cast<float>(randomInt(static_cast<int>(worldBounds.width)));
+        startPosition.y = worldBounds.top - mobBounds.height / 2;
+        velocity = sf::Vector2f(randomInt(200) - 100, baseSpeed); // Random horizontal component, fixed downward component
+        break;
+    case 1: // Right
+        startPosition.x = worldBounds.left + worldBounds.width + mobBounds.width / 2;
+        startPosition.y = worldBounds.top + static_cast<float>(randomInt(static_cast<int>(worldBounds.height)));
+        velocity = sf::Vector2f(-baseSpeed, randomInt(200) - 100); // Fixed leftward component, random vertical component
+        break;
+    case 2: // Bottom
+        startPosition.x = worldBounds.left + static_cast<float>(randomInt(static_cast<int>(worldBounds.width)));
+        startPosition.y = worldBounds.top + worldBounds.height + mobBounds.height / 2;
+        velocity = sf::Vector2f(randomInt(200) - 100, -baseSpeed); // Random horizontal component, fixed upward component
+        break;
+    case 3: // Left
+        startPosition.x = worldBounds.left - mobBounds.width / 2;
+        startPosition.y = worldBounds.top + static_cast<float>(randomInt(static_cast<int>(worldBounds.height)));
+        velocity = sf::Vector2f(baseSpeed, randomInt(200) - 100); // Fixed rightward component, random vertical component
+        break;
+    }
+
+    float velMagnitude = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    float velAngle = std::atan2(velocity.y, velocity.x) + angleDeviation;
+    velocity = sf::Vector2f(std::cos(velAngle) * velMagnitude, std::sin(velAngle) * velMagnitude);
+
+    spawns->position[newMob] = startPosition;
+    spawns->velocity[newMob] = velocity;
+}
+
+/*
+ *  Resets the specified entity to its initial state by repositioning it to the centre of the game area,
+ *  nullifying its velocity, and setting its rotation to zero. This function is typically invoked
+ *  following events such as player loses a life or game restarts to ensure a consistent starting point.
+ *
+ *  Parameters:
+ *    store, index: The entity that requires reinitialisation.
+ *
+ *  Functionality:
+ *    - Repositions the entity to the central point of the play area.
+ *    - Sets the entity's velocity to a standstill (0.0f, 0.0f) to halt any movement.
+ *    - Resets the entity's orientation by setting its rotation angle to zero.
+ */
+void Simulation::reset(EntityStore& store, std::size_t index) {
+    store.position[index] = world.getCenter();
+    store.velocity[index] = sf::Vector2f(0.0f, 0.0f);
+    store.rotation[index] = 0.0f;
+}
+
+
+/*
+ *  Prepares the game for a new session by resetting stats, clearing entities,
+ *  and spawning initial mobs. Used at game start or after a game over.
+ */
+void Simulation::setUp() {
+    gameOver = false;
+    score = 0;
+    lives = 3;
+    projectiles.clear();
+    asteroids.clear();
+    enemyShips.clear();
+    projectileCommands.clear();
+    asteroidCommands.clear();
+    enemyShipCommands.clear();
+    reset(players, 0);
+
+    asteroidSpawnTimer = sf::Time::Zero;
+    enemyShipSpawnTimer = sf::Time::Zero;
+
+    for (int i = 0; i < 2; i++) {
+        spawnMob(EntityStore::Type::Asteroid);
+        spawnMob(EntityStore::Type::EnemyShip);
+    }
+
+    asteroidCommands.flush();
+    enemyShipCommands.flush();
+
+}
+
+/*
+ *  Decreases player lives. Sets game over if no lives left,
+ *  resets player and initiates grace period to prevent immediate collisions.
+ */
+void Simulation::removeLife() {
+    lives -= 1;
+
+
+    if (lives <= 0) {
+        gameOver = true;
+        return;
+    }
+
+    reset(players, 0);
+    inGracePeriod = true;
+    gracePeriodTimer = sf::Time::Zero;
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include "CommandBuffer.h"
+#include "FrameArena.h"
+#include "EntityStore.h"
+#include "AsteroidSystem.h"
+#include "EnemyShipSystem.h"
+#include "PlayerSystem.h"
+#include "ProjectileSystem.h"
+#include "TextureManager.h"
+#include "World.h"
+#include "SpatialHash.h"
+#include "InputSource.h"
+
+/*
+ *  The game itself: the player, mobs and projectiles, spawning, collision, score and
+ *  lives, advanced one update at a time from a PlayerInput. Entities live in one
+ *  EntityStore per type (the player's ship, asteroids, enemy ships and projectiles),
+ *  and each type's system runs a plain loop over its own store. It never touches a window,
+ *  so it can be driven by GameLoop for play or by HeadlessLoop with no graphics at all.
+ *  Given the same seed and the same inputs at the same fixed timestep, every run is
+ *  bit-identical (see stateHash).
+ */
+class Simulation {
+public:
+    Simulation(const sf::FloatRect& worldBounds, unsigned int seed, bool headless = false);
+    virtual ~Simulation();
+
+    void update(sf::Time deltaTime, const PlayerInput& input);
+    void setUp();
+    World& getWorld();
+
+    bool collides(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+        const sf::Vector2f& offset2 = sf::Vector2f(0.0f, 0.0f));
+    bool sweptCollision(const EntityStore& projectiles, std::size_t projectile, const EntityStore& store, std::size_t index,
+        const sf::Vector2f& offset = sf::Vector2f(0.0f, 0.0f));
+    bool pixelPerfectCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+        const sf::Vector2f& offset2 = sf::Vector2f(0.0f, 0.0f));
+    bool polygonCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+        const sf::Vector2f& offset2 = sf::Vector2f(0.0f, 0.0f));
+    bool boundingBoxCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2);
+    bool circleCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+        const sf::Vector2f& offset2 = sf::Vector2f(0.0f, 0.0f));
+    bool orientedBoxCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+        const sf::Vector2f& offset2 = sf::Vector2f(0.0f, 0.0f));
+
+    // Narrowphase pairs and how many each tier rejected, reset once a second
+    struct CollisionStats {
+        int pairs = 0;
+        int circleRejected = 0;
+        int boxRejected = 0;
+        int maskRejected = 0;
+        int hullRejected = 0;
+        int hits = 0;
+    };
+
+    const CollisionStats& getCollisionStats() const;
+    void resetCollisionStats();
+
+    // Final collision test used for an entity type once a pair passes the midphase
+    enum class CollisionMode { Pixel, Polygon };
+
+    void setCollisionMode(EntityStore::Type type, CollisionMode mode);
+    CollisionMode getCollisionMode(EntityStore::Type type) const;
+
+    EntityStore& getPlayers();
+    EntityStore& getProjectiles();
+    EntityStore& getAsteroids();
+    EntityStore& getEnemyShips();
+    const TextureManager& getTextureManager() const;
+    int getScore() const;
+    int getLives() const;
+    bool isGameOver() const;
+    bool isInGracePeriod() const;
+    sf::Time getGracePeriodTimer() const;
+    unsigned int getSeed() const;
+    const FrameArena& getFrameArena() const;
+    std::uint64_t stateHash() const;
+
+private:
+    const float PI = 3.14159265358979323846f;
+
+    // How far a pair got through collides' tests, ordered so later tiers compare greater.
+    // Only one of MaskRejected and HullRejected applies to a given pair
+    enum class CollisionOutcome { NotSolid, CircleRejected, BoxRejected, MaskRejected, HullRejected, Hit };
+
+    World world;
+
+    // Every random choice comes from here, so a seed fully determines a run
+    unsigned int seed;
+    std::mt19937 random;
+
+    // Holds everything that only lives for one update: pending spawns and destroys, the
+    // broadphase grid and query results. Reset at the start of update, and everything taken
+    // from it is given back before update returns. Declared before anything that uses it.
+    FrameArena frameArena;
+
+    EntityStore players;
+    EntityStore asteroids;
+    EntityStore enemyShips;
+    EntityStore projectiles;
+
+    // Projectiles live in a fixed pool; shots fired while it is full are dropped. Mob stores
+    // are reserved generously up front but still grow, so spawns and split pieces are never lost
+    std::size_t maxProjectiles = 512;
+    std::size_t reservedAsteroids = 1024;
+    std::size_t reservedEnemyShips = 128;
+
+    // Spawns and destroys requested during an update, applied together at its end
+    CommandBuffer asteroidCommands;
+    CommandBuffer enemyShipCommands;
+    CommandBuffer projectileCommands;
+
+    bool gameOver = false;
+    bool inGracePeriod;
+
+    int score;
+    int lives;
+
+    TextureManager* textureManager;
+    ProjectileSystem* projectileSystem;
+    AsteroidSystem* asteroidSystem;
+    EnemyShipSystem* enemyShipSystem;
+    PlayerSystem* playerSystem;
+
+    sf::Time gracePeriodDuration;
+    sf::Time gracePeriodTimer;
+    sf::Time asteroidSpawnTimer;
+    sf::Time enemyShipSpawnTimer;
+    sf::Time timeSinceLastFire;
+
+    enum CollisionLayer : unsigned int { AsteroidLayer = 1, EnemyShipLayer = 2, ProjectileLayer = 4 };
+    SpatialHash broadphase;
+    std::pmr::vector<std::size_t> broadphaseResults;
+    int broadphaseDivisions = 16;
+    bool wrapCollisions = true;
+    bool continuousCollision = true;
+    CollisionStats collisionStats;
+    CollisionMode collisionModes[4] = { CollisionMode::Pixel, CollisionMode::Pixel, CollisionMode::Pixel, CollisionMode::Pixel };
+
+    void applyInput(sf::Time deltaTime, const PlayerInput& input);
+    int randomInt(int max);
+    void spawnMob(EntityStore::Type type);
+    void settleOnScreen(EntityStore& mobs);
+    void wrapAround(EntityStore& store);
+    void buildBroadphase();
+    void collide();
+    void collidePlayer(EntityStore& mobs, CommandBuffer& commands, CollisionLayer layer, bool splits);
+    bool collideProjectile(std::size_t projectile, EntityStore& mobs, CommandBuffer& commands, CollisionLayer layer, bool splits);
+    sf::FloatRect sweptBounds(std::size_t projectile) const;
+    CollisionOutcome testCollision(const EntityStore& store1, std::size_t index1, const EntityStore& store2, std::size_t index2,
+        const sf::Vector2f& offset2);
+    void countCollision(CollisionOutcome outcome);
+    sf::Vector2f wrapOffset(const EntityStore& fromStore, std::size_t from, const EntityStore& toStore, std::size_t to) const;
+    void boundingCircle(const EntityStore& store, std::size_t index, sf::Vector2f& centre, float& radius) const;
+    sf::Transform textureTransform(const EntityStore& store, std::size_t index, const sf::Vector2f& offset) const;
+    void orientedBox(const EntityStore& store, std::size_t index, const sf::Vector2f& offset, sf::Vector2f corners[4]) const;
+    bool isOnScreen(const EntityStore& store, std::size_t index);
+    bool isFullyOnScreen(const EntityStore& store, std::size_t index);
+    void reset(EntityStore& store, std::size_t index);
+    void removeLife();
+};
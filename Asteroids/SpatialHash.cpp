@@ -0,0 +1,283 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+/*
+ *  Parameters:
+ *    resource: Where the grid's storage comes from, normally a FrameArena.
+ */
+SpatialHash::SpatialHash(std::pmr::memory_resource* resource)
+    : cellWidth(1.0f), cellHeight(1.0f), columns(0), rows(0), wrapping(false),
+    entries(resource), cells(resource), visited(resource), queryStamp(0) {
+
+}
+
+/*
+ *  Clears all entries and lays the grid out over the given world bounds.
+ *  Cell storage is kept until release(), so rebuilding more than once between
+ *  releases reuses it.
+ *
+ *  Parameters:
+ *    bounds:   The area the grid covers, normally the current view bounds.
+ *    cellSize: The approximate width and height of a cell in world units. Cells are
+ *              stretched slightly so a whole number of them spans the bounds.
+ *    wrapping: True to treat the bounds as a torus, as the screen wrap does.
+ */
+void SpatialHash::reset(const sf::FloatRect& bounds, float cellSize, bool wrapping) {
+    worldBounds = bounds;
+    this->wrapping = wrapping;
+    cellSize = std::max(cellSize, 1.0f);
+
+    int newColumns = std::max(1, static_cast<int>(std::ceil(bounds.width / cellSize)));
+    int newRows = std::max(1, static_cast<int>(std::ceil(bounds.height / cellSize)));
+
+    cellWidth = std::max(bounds.width / newColumns, 1.0f);
+    cellHeight = std::max(bounds.height / newRows, 1.0f);
+
+    if (newColumns != columns || newRows != rows) {
+        columns = newColumns;
+        rows = newRows;
+        cells.resize(static_cast<std::size_t>(columns) * rows);
+    }
+
+    for (auto& cell : cells) {
+        cell.clear();
+    }
+
+    entries.clear();
+}
+
+/*
+ *  Drops every entry and cell and hands their memory back to the resource. The grid
+ *  has to be reset before it is used again.
+ */
+void SpatialHash::release() {
+    std::pmr::vector<Entry>(entries.get_allocator()).swap(entries);
+    std::pmr::vector<std::pmr::vector<std::size_t>>(cells.get_allocator()).swap(cells);
+    std::pmr::vector<unsigned int>(visited.get_allocator()).swap(visited);
+
+    columns = 0;
+    rows = 0;
+    queryStamp = 0;
+}
+
+/*
+ *  Adds an entity to every cell its bounds touch. In wrapping mode, an entity that
+ *  straddles an edge is also added to the cells on the opposite side.
+ *
+ *  Parameters:
+ *    id:     Caller-defined identifier returned by queries, e.g. an index into a container.
+ *    bounds: The entity's axis-aligned bounds in world coordinates.
+ *    layer:  Bit identifying which group the entity belongs to, used to filter queries.
+ *    wraps:  True if the entity wraps around the screen edges.
+ */
+void SpatialHash::insert(std::size_t id, const sf::FloatRect& bounds, unsigned int layer, bool wraps) {
+    std::size_t entryIndex = entries.size();
+    entries.push_back({ id, bounds, layer, wraps });
+
+    int minX, minY, maxX, maxY;
+    cellRange(bounds, minX, minY, maxX, maxY);
+
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            cells[cellIndex(x, y)].push_back(entryIndex);
+        }
+    }
+}
+
+/*
+ *  Collects the ids of entities on the requested layers whose bounds intersect an area.
+ *  Each id is reported once, in no particular order, and appended to results.
+ *
+ *  Parameters:
+ *    area:    The area to search, in world coordinates.
+ *    layers:  Bitmask of layers to include.
+ *    results: Receives the matching ids.
+ *    wraps:   True if the area belongs to a wrapping entity.
+ */
+void SpatialHash::queryRect(const sf::FloatRect& area, unsigned int layers, std::pmr::vector<std::size_t>& results, bool wraps) const {
+    gather(area, layers, wraps, nullptr, 0.0f, results);
+}
+
+/*
+ *  Collects the ids of entities on the requested layers whose bounds come within
+ *  radius of a point. Each id is reported once, in no particular order.
+ *
+ *  Parameters:
+ *    centre:  The centre of the search circle.
+ *    radius:  The radius of the search circle.
+ *    layers:  Bitmask of layers to include.
+ *    results: Receives the matching ids.
+ *    wraps:   True if the circle belongs to a wrapping entity.
+ */
+void SpatialHash::queryRadius(const sf::Vector2f& centre, float radius, unsigned int layers, std::pmr::vector<std::size_t>& results, bool wraps) const {
+    sf::FloatRect area(centre.x - radius, centre.y - radius, radius * 2.0f, radius * 2.0f);
+    gather(area, layers, wraps, &centre, radius, results);
+}
+
+/*
+ *  Returns the translation, in whole multiples of the world size, that moves the
+ *  point "to" onto its wrapped image closest to "from". Adding it to an entity's
+ *  position gives the copy that can actually touch the other entity, so a wrapped
+ *  pair only needs to be tested once. Always zero when not in wrapping mode.
+ */
+sf::Vector2f SpatialHash::wrapOffset(const sf::Vector2f& from, const sf::Vector2f& to) const {
+    if (!wrapping) {
+        return sf::Vector2f(0.0f, 0.0f);
+    }
+
+    float width = worldBounds.width;
+    float height = worldBounds.height;
+
+    sf::Vector2f offset;
+    offset.x = width > 0.0f ? -width * std::floor((to.x - from.x) / width + 0.5f) : 0.0f;
+    offset.y = height > 0.0f ? -height * std::floor((to.y - from.y) / height + 0.5f) : 0.0f;
+    return offset;
+}
+
+/*
+ *  Limits a shift of a wrapping entity to the copies of it that are drawn: across the
+ *  left or right edge only if its bounds straddle the edge it would come in from, and
+ *  likewise vertically. Used when only one of a pair wraps, so the other never touches
+ *  an image of it that is not on screen.
+ *
+ *  Parameters:
+ *    bounds: The wrapping entity's bounds.
+ *    shift:  A translation of it, e.g. from wrapOffset.
+ *
+ *  Returns:
+ *    The shift, with each component that has no drawn copy set to zero.
+ */
+sf::Vector2f SpatialHash::drawnCopyShift(const sf::FloatRect& bounds, sf::Vector2f shift) const {
+    float right = worldBounds.left + worldBounds.width;
+    float bottom = worldBounds.top + worldBounds.height;
+
+    if (!(shift.x > 0.0f && bounds.left < worldBounds.left) && !(shift.x < 0.0f && bounds.left + bounds.width > right)) {
+        shift.x = 0.0f;
+    }
+
+    if (!(shift.y > 0.0f && bounds.top < worldBounds.top) && !(shift.y < 0.0f && bounds.top + bounds.height > bottom)) {
+        shift.y = 0.0f;
+    }
+
+    return shift;
+}
+
+bool SpatialHash::isWrapping() const {
+    return wrapping;
+}
+
+/*
+ *  Returns the number of entities inserted since the last reset.
+ */
+std::size_t SpatialHash::size() const {
+    return entries.size();
+}
+
+/*
+ *  Converts an area into the inclusive range of cells it covers. Without wrapping the
+ *  range is clamped to the grid; with wrapping it may run past the edges (cellIndex
+ *  folds it back) but never covers more than one full lap.
+ */
+void SpatialHash::cellRange(const sf::FloatRect& area, int& minX, int& minY, int& maxX, int& maxY) const {
+    minX = static_cast<int>(std::floor((area.left - worldBounds.left) / cellWidth));
+    maxX = static_cast<int>(std::floor((area.left + area.width - worldBounds.left) / cellWidth));
+    minY = static_cast<int>(std::floor((area.top - worldBounds.top) / cellHeight));
+    maxY = static_cast<int>(std::floor((area.top + area.height - worldBounds.top) / cellHeight));
+
+    if (wrapping) {
+        maxX = std::min(maxX, minX + columns - 1);
+        maxY = std::min(maxY, minY + rows - 1);
+        return;
+    }
+
+    minX = std::max(0, std::min(minX, columns - 1));
+    maxX = std::max(0, std::min(maxX, columns - 1));
+    minY = std::max(0, std::min(minY, rows - 1));
+    maxY = std::max(0, std::min(maxY, rows - 1));
+}
+
+/*
+ *  Returns the storage index of a cell, folding out-of-range coordinates back onto the grid.
+ */
+std::size_t SpatialHash::cellIndex(int x, int y) const {
+    x = ((x % columns) + columns) % columns;
+    y = ((y % rows) + rows) % rows;
+    return static_cast<std::size_t>(y) * columns + x;
+}
+
+/*
+ *  Walks the cells covered by an area and appends each matching entry's id once.
+ *  When both sides wrap, the entry is compared at its wrapped image nearest the area; when
+ *  only one does, only at that image if it is a drawn copy of the wrapping side.
+ *  When a centre is given, entries are also required to come within radius of it,
+ *  measured to the closest point on their bounds.
+ */
+void SpatialHash::gather(const sf::FloatRect& area, unsigned int layers, bool wraps, const sf::Vector2f* centre, float radius, std::pmr::vector<std::size_t>& results) const {
+    if (entries.empty()) {
+        return;
+    }
+
+    if (visited.size() < entries.size()) {
+        visited.resize(entries.size(), 0);
+    }
+
+    if (++queryStamp == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        queryStamp = 1;
+    }
+
+    sf::Vector2f areaCentre(area.left + area.width / 2.0f, area.top + area.height / 2.0f);
+
+    int minX, minY, maxX, maxY;
+    cellRange(area, minX, minY, maxX, maxY);
+
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            for (std::size_t entryIndex : cells[cellIndex(x, y)]) {
+                if (visited[entryIndex] == queryStamp) {
+                    continue;
+                }
+                visited[entryIndex] = queryStamp;
+
+                const Entry& entry = entries[entryIndex];
+                if (!(entry.layer & layers)) {
+                    continue;
+                }
+
+                sf::FloatRect bounds = entry.bounds;
+                if (wraps || entry.wraps) {
+                    sf::Vector2f entryCentre(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+                    sf::Vector2f offset = wrapOffset(areaCentre, entryCentre);
+
+                    if (!entry.wraps) {
+                        offset = -drawnCopyShift(area, -offset);
+                    }
+                    else if (!wraps) {
+                        offset = drawnCopyShift(bounds, offset);
+                    }
+
+                    bounds.left += offset.x;
+                    bounds.top += offset.y;
+                }
+
+                if (!bounds.intersects(area)) {
+                    continue;
+                }
+
+                if (centre != nullptr) {
+                    float closestX = std::max(bounds.left, std::min(centre->x, bounds.left + bounds.width));
+                    float closestY = std::max(bounds.top, std::min(centre->y, bounds.top + bounds.height));
+                    float dx = centre->x - closestX;
+                    float dy = centre->y - closestY;
+
+                    if (dx * dx + dy * dy > radius * radius) {
+                        continue;
+                    }
+                }
+
+                results.push_back(entry.id);
+            }
+        }
+    }
+}
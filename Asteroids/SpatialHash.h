@@ -0,0 +1,65 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/*
+ *  Uniform grid broadphase. Entities are inserted each tick with an id, their
+ *  axis-aligned bounds and a layer bit, and can then be looked up by area or
+ *  radius so only nearby pairs reach the expensive collision tests.
+ *
+ *  The grid covers the bounds given to reset(); anything outside is clamped into
+ *  the border cells, so off-screen entities are still found, just less selectively.
+ *
+ *  In wrapping mode the bounds are treated as a torus, matching the screen wrap drawn by
+ *  GameLoop: cell coordinates wrap around, entities straddling an edge are also
+ *  registered in the cells on the opposite side. An entry and a query that both wrap are
+ *  compared at the nearest wrapped image of each other. When only one side wraps, the
+ *  other is only compared against the copies of it GameLoop actually draws, i.e. shifted
+ *  across an edge it straddles (see drawnCopyShift).
+ *
+ *  The entries, cells and query bookkeeping all come from the resource given at
+ *  construction. Rebuilt every tick from a FrameArena they never touch the heap, as long
+ *  as release() is called once the tick's queries are done and before the arena resets.
+ */
+class SpatialHash {
+public:
+    explicit SpatialHash(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    void reset(const sf::FloatRect& bounds, float cellSize, bool wrapping = false);
+    void release();
+    void insert(std::size_t id, const sf::FloatRect& bounds, unsigned int layer, bool wraps = false);
+    void queryRect(const sf::FloatRect& area, unsigned int layers, std::pmr::vector<std::size_t>& results, bool wraps = false) const;
+    void queryRadius(const sf::Vector2f& centre, float radius, unsigned int layers, std::pmr::vector<std::size_t>& results, bool wraps = false) const;
+    sf::Vector2f wrapOffset(const sf::Vector2f& from, const sf::Vector2f& to) const;
+    sf::Vector2f drawnCopyShift(const sf::FloatRect& bounds, sf::Vector2f shift) const;
+    bool isWrapping() const;
+    std::size_t size() const;
+
+private:
+    struct Entry {
+        std::size_t id;
+        sf::FloatRect bounds;
+        unsigned int layer;
+        bool wraps;
+    };
+
+    void gather(const sf::FloatRect& area, unsigned int layers, bool wraps, const sf::Vector2f* centre, float radius, std::pmr::vector<std::size_t>& results) const;
+    void cellRange(const sf::FloatRect& area, int& minX, int& minY, int& maxX, int& maxY) const;
+    std::size_t cellIndex(int x, int y) const;
+
+    sf::FloatRect worldBounds;
+    float cellWidth;
+    float cellHeight;
+    int columns;
+    int rows;
+    bool wrapping;
+
+    std::pmr::vector<Entry> entries;
+    std::pmr::vector<std::pmr::vector<std::size_t>> cells;
+
+    // Per-entry stamp so an entity spanning several cells is reported once per query
+    mutable std::pmr::vector<unsigned int> visited;
+    mutable unsigned int queryStamp;
+};
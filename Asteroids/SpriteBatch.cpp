@@ -0,0 +1,133 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+
+SpriteBatch::SpriteBatch(const TextureManager& textureManager) : textureManager(&textureManager) {
+
+}
+
+/*
+ *  Queues a quad covering a whole texture, on its atlas page.
+ *
+ *  Parameters:
+ *    texture:   The texture to draw.
+ *    transform: Maps the texture's pixel coordinates to world coordinates, e.g. from
+ *               EntityStore::getTransform.
+ *    size:      The texture's size in pixels.
+ *    offset:    Added to every corner after the transform, to place a wrapped copy.
+ */
+void SpriteBatch::add(TextureManager::Handle texture, const sf::Transform& transform, const sf::Vector2f& size,
+    const sf::Vector2f& offset) {
+
+    std::size_t page = textureManager->getAtlasPage(texture);
+    if (page >= vertices.size()) {
+        vertices.resize(page + 1);
+    }
+
+    std::vector<sf::Vertex>& quads = vertices[page];
+    if (quads.empty()) {
+        pending.push_back(page);
+    }
+
+    sf::IntRect rect = textureManager->getTextureRect(texture);
+    sf::Vector2f origin(static_cast<float>(rect.left), static_cast<float>(rect.top));
+
+    const sf::Vector2f corners[4] = {
+        sf::Vector2f(0.0f, 0.0f),
+        sf::Vector2f(size.x, 0.0f),
+        sf::Vector2f(size.x, size.y),
+        sf::Vector2f(0.0f, size.y)
+    };
+
+    for (const sf::Vector2f& corner : corners) {
+        quads.push_back(sf::Vertex(transform.transformPoint(corner) + offset, origin + corner));
+    }
+}
+
+/*
+ *  Draws every queued quad, one draw call per atlas page in the order the pages were
+ *  first added to, and empties the batch.
+ *
+ *  Returns:
+ *    The number of draw calls made.
+ */
+std::size_t SpriteBatch::draw(sf::RenderTarget& target) {
+    std::size_t drawCalls = pending.size();
+
+    for (std::size_t page : pending) {
+        std::vector<sf::Vertex>& quads = vertices[page];
+        sf::RenderStates states(&textureManager->getAtlasTexture(page));
+
+        if (stream(page)) {
+            target.draw(buffers[page], 0, quads.size(), states);
+        }
+        else {
+            target.draw(quads.data(), quads.size(), sf::Quads, states);
+        }
+
+        quads.clear();
+    }
+
+    pending.clear();
+    return drawCalls;
+}
+
+/*
+ *  Drops every queued quad without drawing it.
+ */
+void SpriteBatch::clear() {
+    for (std::size_t page : pending) {
+        vertices[page].clear();
+    }
+
+    pending.clear();
+}
+
+/*
+ *  Chooses whether quads are streamed through vertex buffers, where the driver supports
+ *  them, or always drawn from memory. On by default; turning it off is mostly useful to
+ *  compare the two paths.
+ */
+void SpriteBatch::setUseVertexBuffers(bool use) {
+    useVertexBuffers = use;
+}
+
+/*
+ *  Returns true if draw streams quads through vertex buffers. Needs an active OpenGL
+ *  context to check the driver, as any render target provides.
+ */
+bool SpriteBatch::isUsingVertexBuffers() const {
+    return useVertexBuffers && sf::VertexBuffer::isAvailable();
+}
+
+/*
+ *  Copies a page's queued quads into its vertex buffer, growing the buffer to at least
+ *  double its size when they no longer fit. Only the vertices queued this frame are
+ *  written; whatever lies beyond them is left over from earlier frames and not drawn.
+ *
+ *  Returns:
+ *    True if the buffer now holds the quads, false if they have to be drawn from memory.
+ */
+bool SpriteBatch::stream(std::size_t page) {
+    if (!isUsingVertexBuffers()) {
+        return false;
+    }
+
+    if (page >= buffers.size()) {
+        buffers.resize(page + 1);
+    }
+
+    sf::VertexBuffer& buffer = buffers[page];
+    const std::vector<sf::Vertex>& quads = vertices[page];
+
+    if (buffer.getVertexCount() < quads.size()) {
+        std::size_t capacity = std::max(std::max(minimumBufferSize, buffer.getVertexCount() * 2), quads.size());
+
+        buffer.setPrimitiveType(sf::Quads);
+        buffer.setUsage(sf::VertexBuffer::Stream);
+        if (!buffer.create(capacity)) {
+            return false;
+        }
+    }
+
+    return buffer.update(quads.data(), quads.size(), 0);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include "TextureManager.h"
+
+/*
+ *  Collects textured quads and draws all the quads on the same TextureManager atlas page
+ *  with one draw call, in the order they were added. As every image normally shares one
+ *  page, a whole frame of entities of every type is a single draw. Each quad is placed by
+ *  a full transform, so rotated entities keep their shape, and may be shifted by an offset
+ *  in world units to draw a wrapped copy of the same entity.
+ *
+ *  Vertex storage is kept between frames, so a batch stops allocating once it has seen
+ *  the busiest frame. Where the driver supports vertex buffers, each page's quads are
+ *  streamed into a persistent sf::VertexBuffer, grown geometrically, and only the range
+ *  in use this frame is written. Elsewhere, or if an upload fails, quads are drawn
+ *  straight from memory as a vertex array would be. Both paths work with any render
+ *  target, including an offscreen sf::RenderTexture.
+ */
+class SpriteBatch {
+public:
+    explicit SpriteBatch(const TextureManager& textureManager);
+
+    void add(TextureManager::Handle texture, const sf::Transform& transform, const sf::Vector2f& size,
+        const sf::Vector2f& offset = sf::Vector2f(0.0f, 0.0f));
+    std::size_t draw(sf::RenderTarget& target);
+    void clear();
+
+    void setUseVertexBuffers(bool use);
+    bool isUsingVertexBuffers() const;
+
+private:
+    const TextureManager* textureManager;
+
+    // Quads waiting to be drawn, indexed by atlas page
+    std::vector<std::vector<sf::Vertex>> vertices;
+
+    // Pages with quads waiting, in the order they were first added to
+    std::vector<std::size_t> pending;
+
+    // GPU copies of vertices, indexed by atlas page. A deque, so adding a page never
+    // copies the existing buffers
+    std::deque<sf::VertexBuffer> buffers;
+    bool useVertexBuffers = true;
+    std::size_t minimumBufferSize = 1024; // Vertices
+
+    bool stream(std::size_t page);
+};
@@ -1,13 +1,23 @@
 #include "TextureManager.h"
+#include <numeric>
 
 
-TextureManager::TextureManager() {
+/*
+ *  Parameters:
+ *    uploadTextures: False to keep every texture on the CPU only, for running without a
+ *                    window or graphics context. Textures are then left empty, but their
+ *                    sizes, collision masks and hulls are still available.
+ */
+TextureManager::TextureManager(bool uploadTextures) : uploadTextures(uploadTextures) {
 
 
 }
 
 /*
- *  Loads a texture from the specified file path, scales it, and stores it in the texture manager.
+ *  Loads a texture from the specified file path, scales it, and stores it in the texture manager
+ *  along with a collision mask and convex collision hull built from the scaled image's alpha channel.
+ *  The file is only decoded the first time it is loaded. The image is not drawable until the
+ *  next buildAtlas.
  *  Throws a runtime_error if the loading or scaling fails.
  *
  *  Parameters:
@@ -17,10 +27,7 @@ TextureManager::TextureManager() {
  *    scaleY:  The scale factor for the texture along the y-axis.
  */
 void TextureManager::loadTexture(const std::string& name, const std::string& path, float scaleX, float scaleY) {
-    sf::Image originalImage;
-    if (!originalImage.loadFromFile(path)) {
-        throw std::runtime_error("Failed to load image from " + path);
-    }
+    const sf::Image& originalImage = decode(path);
 
     sf::Vector2u originalSize = originalImage.getSize();
     sf::Image scaledImage;
@@ -36,50 +43,161 @@ void TextureManager::loadTexture(const std::string& name, const std::string& pat
         }
     }
 
-    sf::Texture texture;
-    if (!texture.loadFromImage(scaledImage)) {
-        throw std::runtime_error("Failed to create texture from scaled image");
+    textures.emplace_back(name);
+    textures.back().image = scaledImage;
+    textures.back().mask = CollisionMask(scaledImage);
+    textures.back().hull = CollisionHull(textures.back().mask);
+    atlasBuilt = false;
+}
+
+/*
+ *  Returns the decoded contents of an image file, decoding it on first use.
+ *  Throws a runtime_error if the file cannot be loaded.
+ */
+const sf::Image& TextureManager::decode(const std::string& path) {
+    auto it = sourceImages.find(path);
+    if (it != sourceImages.end()) {
+        return it->second;
+    }
+
+    sf::Image image;
+    if (!image.loadFromFile(path)) {
+        throw std::runtime_error("Failed to load image from " + path);
     }
 
-    textures.emplace_back(name);
-    textures.back().texture = std::move(texture);
+    return sourceImages.emplace(path, std::move(image)).first->second;
 }
 
 
 /*
- *  Retrieves a texture from the texture manager by name.
- *  Throws a runtime_error if the texture with the specified name is not found.
+ *  Retrieves the atlas page holding a texture, by name. The texture is the part of the
+ *  page given by getTextureRect.
+ *  Throws a runtime_error if the texture with the specified name is not found, or if the
+ *  atlas is out of date.
  *
  *  Parameters:
  *    name: The name of the texture to retrieve.
  *
  *  Returns:
- *    A const reference to the texture associated with the specified name.
+ *    A const reference to the atlas page texture.
  */
 const sf::Texture& TextureManager::getTexture(const std::string& name) const {
+    checkAtlas();
+    return atlasPages[find(name)->page];
+}
+
+
+/*
+ *  Rotates a texture by the specified angle and updates it in the texture manager.
+ *  The rotation is done on the CPU copy of the image, sampling the nearest source pixel
+ *  like an unsmoothed texture would, so it also works when textures are not uploaded.
+ *  The collision mask and hull are rebuilt from the rotated image so they stay in sync.
+ *  The rotated image is not drawable until the next buildAtlas.
+ *  Throws a runtime_error if the texture with the specified name is not found.
+ *
+ *  Parameters:
+ *    name:  The name of the texture to rotate.
+ *    angle: The angle by which to rotate the texture.
+ */
+
+void TextureManager::rotateTexture(const std::string& name, float angle) {
     auto it = std::find_if(textures.begin(), textures.end(), [&name](const TextureInfo& info) {
         return info.name == name;
         });
 
-    if (it != textures.end()) {
-        return it->texture;
+    if (it == textures.end()) {
+        throw std::runtime_error("Texture not found: " + name);
+    }
+
+    sf::Vector2u size = it->image.getSize();
+    sf::FloatRect bounds(0.0f, 0.0f, static_cast<float>(size.x), static_cast<float>(size.y));
+    sf::Transform rotation;
+    rotation.rotate(angle, bounds.width / 2, bounds.height / 2);
+    sf::FloatRect rotatedBounds = rotation.transformRect(bounds);
+
+    sf::Image rotatedImage;
+    rotatedImage.create(static_cast<unsigned int>(rotatedBounds.width), static_cast<unsigned int>(rotatedBounds.height), sf::Color::Transparent);
+
+    // Maps each pixel centre of the rotated image back to the pixel it came from
+    sf::Transform toSource;
+    toSource.translate(bounds.width / 2.0f, bounds.height / 2.0f);
+    toSource.rotate(-angle);
+    toSource.translate(-rotatedBounds.width / 2.0f, -rotatedBounds.height / 2.0f);
+
+    for (unsigned int y = 0; y < rotatedImage.getSize().y; ++y) {
+        for (unsigned int x = 0; x < rotatedImage.getSize().x; ++x) {
+            sf::Vector2f source = toSource.transformPoint(x + 0.5f, y + 0.5f);
+
+            if (source.x >= 0.0f && source.y >= 0.0f && source.x < bounds.width && source.y < bounds.height) {
+                rotatedImage.setPixel(x, y, it->image.getPixel(static_cast<unsigned int>(source.x), static_cast<unsigned int>(source.y)));
+            }
+        }
     }
-    else {
+
+    it->image = rotatedImage;
+    it->mask = CollisionMask(it->image);
+    it->hull = CollisionHull(it->mask);
+    atlasBuilt = false;
+}
+
+
+/*
+ *  Retrieves the collision mask of a texture by name.
+ *  Throws a runtime_error if the texture with the specified name is not found.
+ *
+ *  Parameters:
+ *    name: The name of the texture whose mask to retrieve.
+ *
+ *  Returns:
+ *    A const reference to the collision mask built when the texture was loaded.
+ */
+const CollisionMask& TextureManager::getCollisionMask(const std::string& name) const {
+    auto it = std::find_if(textures.begin(), textures.end(), [&name](const TextureInfo& info) {
+        return info.name == name;
+        });
+
+    if (it == textures.end()) {
         throw std::runtime_error("Texture not found: " + name);
     }
+
+    return it->mask;
 }
 
 
 /*
- *  Rotates a texture by the specified angle and updates it in the texture manager.
+ *  Retrieves the convex collision hull of a texture by name.
  *  Throws a runtime_error if the texture with the specified name is not found.
  *
  *  Parameters:
- *    name:  The name of the texture to rotate.
- *    angle: The angle by which to rotate the texture.
+ *    name: The name of the texture whose hull to retrieve.
+ *
+ *  Returns:
+ *    A const reference to the hull built when the texture was loaded.
  */
+const CollisionHull& TextureManager::getCollisionHull(const std::string& name) const {
+    auto it = std::find_if(textures.begin(), textures.end(), [&name](const TextureInfo& info) {
+        return info.name == name;
+        });
 
-void TextureManager::rotateTexture(const std::string& name, float angle) {
+    if (it == textures.end()) {
+        throw std::runtime_error("Texture not found: " + name);
+    }
+
+    return it->hull;
+}
+
+
+/*
+ *  Looks up the handle of a texture by name, for the per-entity texture columns.
+ *  Throws a runtime_error if the texture with the specified name is not found.
+ *
+ *  Parameters:
+ *    name: The name of the texture.
+ *
+ *  Returns:
+ *    The handle to pass to the handle overloads, which are plain index lookups.
+ */
+TextureManager::Handle TextureManager::getHandle(const std::string& name) const {
     auto it = std::find_if(textures.begin(), textures.end(), [&name](const TextureInfo& info) {
         return info.name == name;
         });
@@ -88,25 +206,190 @@ void TextureManager::rotateTexture(const std::string& name, float angle) {
         throw std::runtime_error("Texture not found: " + name);
     }
 
-    sf::Sprite sprite(it->texture);
+    return static_cast<Handle>(it - textures.begin());
+}
 
-    sf::FloatRect bounds = sprite.getLocalBounds();
-    sf::Transform rotation;
-    rotation.rotate(angle, bounds.width / 2, bounds.height / 2);
-    sf::FloatRect rotatedBounds = rotation.transformRect(bounds);
+/*
+ *  Returns the atlas page holding a texture; see getTextureRect for where on it.
+ *  Throws a runtime_error if the atlas is out of date.
+ */
+const sf::Texture& TextureManager::getTexture(Handle handle) const {
+    checkAtlas();
+    return atlasPages[textures[handle].page];
+}
+
+const CollisionMask& TextureManager::getCollisionMask(Handle handle) const {
+    return textures[handle].mask;
+}
+
+const CollisionHull& TextureManager::getCollisionHull(Handle handle) const {
+    return textures[handle].hull;
+}
+
+/*
+ *  Returns the pixel size of a texture. Unlike sf::Texture::getSize this is also
+ *  correct when textures are not uploaded.
+ */
+sf::Vector2u TextureManager::getTextureSize(Handle handle) const {
+    return textures[handle].image.getSize();
+}
 
-    sprite.setOrigin(bounds.width / 2.0f, bounds.height / 2.0f);
-    sprite.setRotation(angle);
+bool TextureManager::isUploadingTextures() const {
+    return uploadTextures;
+}
 
-    sf::RenderTexture renderTexture;
-    renderTexture.create(static_cast<unsigned int>(rotatedBounds.width), static_cast<unsigned int>(rotatedBounds.height));
-    renderTexture.clear(sf::Color::Transparent);
+/*
+ *  Packs every loaded image into as few atlas pages as it takes and, unless textures are
+ *  kept on the CPU, uploads the pages. Call it once loading and rotating are done, and
+ *  again after any later change. The decoded image files are no longer needed afterwards,
+ *  so they are released.
+ *
+ *  Images are placed tallest first on shelves running across each page, atlasPadding
+ *  pixels apart. A page is cropped to what it holds, and an image too large for a page
+ *  gets a page of its own.
+ *  Throws a runtime_error if a page cannot be uploaded.
+ */
+void TextureManager::buildAtlas() {
+    unsigned int pageSize = atlasPageSize;
+    if (uploadTextures) {
+        pageSize = std::min(pageSize, sf::Texture::getMaximumSize());
+    }
+
+    std::vector<std::size_t> order(textures.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return textures[a].image.getSize().y > textures[b].image.getSize().y;
+        });
+
+    std::vector<sf::Vector2u> pageSizes;
+    bool needPage = true;
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int shelfHeight = 0;
+
+    for (std::size_t index : order) {
+        TextureInfo& info = textures[index];
+        sf::Vector2u size = info.image.getSize();
+
+        if (size.x > pageSize || size.y > pageSize) {
+            info.page = pageSizes.size();
+            info.rect = sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+            pageSizes.push_back(size);
+
+            // Whatever comes next starts a fresh page
+            needPage = true;
+            continue;
+        }
+
+        if (needPage) {
+            x = y = shelfHeight = 0;
+            pageSizes.push_back(sf::Vector2u(0, 0));
+            needPage = false;
+        }
+
+        if (x + size.x > pageSize) {
+            x = 0;
+            y += shelfHeight + atlasPadding;
+            shelfHeight = 0;
+        }
+
+        if (y + size.y > pageSize) {
+            x = y = shelfHeight = 0;
+            pageSizes.push_back(sf::Vector2u(0, 0));
+        }
+
+        info.page = pageSizes.size() - 1;
+        info.rect = sf::IntRect(static_cast<int>(x), static_cast<int>(y), static_cast<int>(size.x), static_cast<int>(size.y));
+
+        sf::Vector2u& used = pageSizes.back();
+        used.x = std::max(used.x, x + size.x);
+        used.y = std::max(used.y, y + size.y);
+
+        x += size.x + atlasPadding;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
 
-    sprite.setPosition(rotatedBounds.width / 2.0f, rotatedBounds.height / 2.0f);
+    atlasPages.clear();
+    atlasPages.resize(pageSizes.size());
 
- 
-    renderTexture.draw(sprite);
-    renderTexture.display();
+    if (uploadTextures) {
+        for (std::size_t page = 0; page < pageSizes.size(); ++page) {
+            sf::Image pageImage;
+            pageImage.create(pageSizes[page].x, pageSizes[page].y, sf::Color::Transparent);
 
-    it->texture = renderTexture.getTexture();
+            for (const TextureInfo& info : textures) {
+                if (info.page == page) {
+                    pageImage.copy(info.image, static_cast<unsigned int>(info.rect.left), static_cast<unsigned int>(info.rect.top));
+                }
+            }
+
+            if (!atlasPages[page].loadFromImage(pageImage)) {
+                throw std::runtime_error("Failed to create texture atlas page");
+            }
+        }
+    }
+
+    sourceImages.clear();
+    atlasBuilt = true;
+}
+
+/*
+ *  Returns where a texture sits on its atlas page, in pixels, by name.
+ *  Throws a runtime_error if the texture is not found or the atlas is out of date.
+ */
+sf::IntRect TextureManager::getTextureRect(const std::string& name) const {
+    checkAtlas();
+    return find(name)->rect;
+}
+
+/*
+ *  Returns where a texture sits on its atlas page, in pixels.
+ *  Throws a runtime_error if the atlas is out of date.
+ */
+sf::IntRect TextureManager::getTextureRect(Handle handle) const {
+    checkAtlas();
+    return textures[handle].rect;
+}
+
+/*
+ *  Returns the index of the atlas page holding a texture, for batching by page.
+ *  Throws a runtime_error if the atlas is out of date.
+ */
+std::size_t TextureManager::getAtlasPage(Handle handle) const {
+    checkAtlas();
+    return textures[handle].page;
+}
+
+const sf::Texture& TextureManager::getAtlasTexture(std::size_t page) const {
+    checkAtlas();
+    return atlasPages[page];
+}
+
+std::size_t TextureManager::getAtlasPageCount() const {
+    return atlasPages.size();
+}
+
+/*
+ *  Finds a texture by name.
+ *  Throws a runtime_error if the texture with the specified name is not found.
+ */
+std::vector<TextureManager::TextureInfo>::const_iterator TextureManager::find(const std::string& name) const {
+    auto it = std::find_if(textures.begin(), textures.end(), [&name](const TextureInfo& info) {
+        return info.name == name;
+        });
+
+    if (it == textures.end()) {
+        throw std::runtime_error("Texture not found: " + name);
+    }
+
+    return it;
+}
+
+/*
+ *  Throws a runtime_error if textures were loaded or rotated since the last buildAtlas.
+ */
+void TextureManager::checkAtlas() const {
+    if (!atlasBuilt) {
+        throw std::runtime_error("Texture atlas is out of date, call buildAtlas after loading textures");
+    }
 }
\ No newline at end of file
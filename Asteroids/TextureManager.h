@@ -1,24 +1,77 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
 #include <vector>
 #include <string>
 #include <algorithm>
 #include <stdexcept>
+#include "CollisionMask.h"
+#include "CollisionHull.h"
 
+/*
+ *  Loads, scales and rotates the game's images, with a collision mask and hull for each,
+ *  and packs them all into one or a few atlas pages. Every image is a sub-rectangle of a
+ *  page, so a renderer can draw entities with different images in one draw call.
+ *
+ *  Images are only uploaded when buildAtlas is called, once everything is loaded and
+ *  rotated; the atlas lookups throw until then. Each image file is decoded once however
+ *  many scaled copies are loaded from it.
+ */
 class TextureManager {
 public:
-    TextureManager();
+    // Index of a loaded texture. Textures are never removed, so a handle stays valid
+    typedef std::uint16_t Handle;
+
+    explicit TextureManager(bool uploadTextures = true);
     void loadTexture(const std::string& name, const std::string& path, float scaleX, float scaleY);
     const sf::Texture& getTexture(const std::string& name) const;
     void rotateTexture(const std::string& name, float angle);
+    const CollisionMask& getCollisionMask(const std::string& name) const;
+    const CollisionHull& getCollisionHull(const std::string& name) const;
+    Handle getHandle(const std::string& name) const;
+    const sf::Texture& getTexture(Handle handle) const;
+    const CollisionMask& getCollisionMask(Handle handle) const;
+    const CollisionHull& getCollisionHull(Handle handle) const;
+    sf::Vector2u getTextureSize(Handle handle) const;
+    bool isUploadingTextures() const;
+
+    void buildAtlas();
+    sf::IntRect getTextureRect(const std::string& name) const;
+    sf::IntRect getTextureRect(Handle handle) const;
+    std::size_t getAtlasPage(Handle handle) const;
+    const sf::Texture& getAtlasTexture(std::size_t page) const;
+    std::size_t getAtlasPageCount() const;
 
 private:
     struct TextureInfo {
-        sf::Texture texture;
+        sf::Image image;
+        CollisionMask mask;
+        CollisionHull hull;
         std::string name;
 
+        // Where the image was packed, see buildAtlas
+        std::size_t page = 0;
+        sf::IntRect rect;
+
         TextureInfo(const std::string& name) : name(name) {}
     };
 
+    const sf::Image& decode(const std::string& path);
+    std::vector<TextureInfo>::const_iterator find(const std::string& name) const;
+    void checkAtlas() const;
+
     std::vector<TextureInfo> textures;
+
+    // Decoded image files by path, so scaled copies of one file share a decode
+    std::map<std::string, sf::Image> sourceImages;
+
+    std::vector<sf::Texture> atlasPages;
+    bool atlasBuilt = false;
+    unsigned int atlasPageSize = 1024;
+    unsigned int atlasPadding = 1; // Transparent pixels between images, so none bleed into another
+
+    // False in headless mode: images are kept on the CPU and textures are never created
+    bool uploadTextures;
 };
\ No newline at end of file
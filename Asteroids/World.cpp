@@ -0,0 +1,38 @@
+#include "World.h"
+#include <algorithm>
+
+World::World(const sf::FloatRect& bounds) : bounds(bounds) {
+
+}
+
+const sf::FloatRect& World::getBounds() const {
+    return bounds;
+}
+
+sf::Vector2f World::getCenter() const {
+    return sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f);
+}
+
+/*
+ *  Changes the area the game is played in, e.g. after the window is resized, and tells
+ *  every listener. Nothing happens if the bounds are unchanged.
+ */
+void World::setBounds(const sf::FloatRect& newBounds) {
+    if (newBounds == bounds) {
+        return;
+    }
+
+    bounds = newBounds;
+
+    for (WorldListener* listener : listeners) {
+        listener->onWorldResized(bounds);
+    }
+}
+
+void World::addListener(WorldListener& listener) {
+    listeners.push_back(&listener);
+}
+
+void World::removeListener(WorldListener& listener) {
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), &listener), listeners.end());
+}
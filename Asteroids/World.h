@@ -0,0 +1,36 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/*
+ *  Notified when the world is resized.
+ */
+class WorldListener {
+public:
+    virtual ~WorldListener() {}
+    virtual void onWorldResized(const sf::FloatRect& bounds) = 0;
+};
+
+/*
+ *  The area the game is played in, shared by everything that needs it. Entities only
+ *  record whether they wrap; the bounds they wrap within are always read from here,
+ *  so a resize reaches every entity at once without touching any of them.
+ *
+ *  Owned by the Simulation. Listeners are not owned and must remove themselves
+ *  before they are destroyed.
+ */
+class World {
+public:
+    explicit World(const sf::FloatRect& bounds);
+
+    const sf::FloatRect& getBounds() const;
+    sf::Vector2f getCenter() const;
+    void setBounds(const sf::FloatRect& bounds);
+
+    void addListener(WorldListener& listener);
+    void removeListener(WorldListener& listener);
+
+private:
+    sf::FloatRect bounds;
+    std::vector<WorldListener*> listeners;
+};
@@ -1,9 +1,100 @@
 #include "GameLoop.h"
+#include "HeadlessLoop.h"
+#include "Profiler.h"
+#include "SelfTest.h"
 #include <iostream>
+#include <string>
+#include <ctime>
 
-int main() {
+/*
+ *  Usage:
+ *    Asteroids [--seed <seed>] [--record <file>] [--trace <file>]
+ *    Asteroids --headless [--seed <seed>] [--ticks <count>] [--replay <file>] [--trace <file>]
+ *    Asteroids --selftest [--headless]
+ *
+ *  --record saves the player's input so the session can be replayed. --headless runs
+ *  the game with no window for the given number of updates (one minute by default),
+ *  using a scripted input pattern unless a recording is replayed. Without --seed the
+ *  seed is taken from the clock; replaying a recording needs the seed it was made with.
+ *  --trace names the Chrome trace file the profiler writes, at the end of a headless run
+ *  or whenever F9 is pressed in the game. Spans are only recorded in ENABLE_PROFILER builds.
+ *  A headless run only reports heap allocations in COUNT_ALLOCATIONS (or TRACK_ALLOCATIONS)
+ *  builds, which replace the global allocator; other builds keep the stock one.
+ *  --selftest runs the checks in SelfTest and exits with 1 if any fail; with --headless
+ *  it skips those that need an OpenGL context.
+ */
+int main(int argc, char* argv[]) {
     try {
-        GameLoop game;
+        bool headless = false;
+        bool selftest = false;
+        int ticks = 3600;
+        unsigned int seed = static_cast<unsigned int>(time(nullptr));
+        std::string recordPath;
+        std::string replayPath;
+        std::string tracePath;
+
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+
+            if (arg == "--headless") {
+                headless = true;
+            }
+            else if (arg == "--selftest") {
+                selftest = true;
+            }
+            else if (arg == "--ticks" && i + 1 < argc) {
+                ticks = std::stoi(argv[++i]);
+            }
+            else if (arg == "--seed" && i + 1 < argc) {
+                seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--record" && i + 1 < argc) {
+                recordPath = argv[++i];
+            }
+            else if (arg == "--replay" && i + 1 < argc) {
+                replayPath = argv[++i];
+            }
+            else if (arg == "--trace" && i + 1 < argc) {
+                tracePath = argv[++i];
+            }
+            else {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                return 1;
+            }
+        }
+
+        if (selftest) {
+            SelfTest test;
+            return test.run(headless) ? 0 : 1;
+        }
+
+        if (headless) {
+            if (replayPath.empty()) {
+                ScriptedInput input;
+                HeadlessLoop loop(input, ticks, seed);
+                loop.run();
+            }
+            else {
+                RecordedInput input(replayPath);
+                HeadlessLoop loop(input, ticks, seed);
+                loop.run();
+            }
+
+            if (!tracePath.empty()) {
+                Profiler::writeTrace(tracePath);
+                std::cout << "Wrote " << Profiler::size() << " profiler spans to " << tracePath << std::endl;
+            }
+            return 0;
+        }
+
+        GameLoop game(seed);
+        if (!recordPath.empty()) {
+            game.record(recordPath);
+            std::cout << "Recording input to " << recordPath << " with seed " << seed << std::endl;
+        }
+        if (!tracePath.empty()) {
+            game.trace(tracePath);
+        }
         game.run();
     }
     catch (const std::exception& e) {